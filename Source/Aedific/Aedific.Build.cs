@@ -12,6 +12,7 @@ public class Aedific : ModuleRules
 			new string[]
 			{
 				"Core",
+				"NetCore",
 			}
 		);
 			
@@ -20,7 +21,16 @@ public class Aedific : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"GeometryCore",
+				"GeometryFramework",
+				"MeshDescription",
+				"StaticMeshDescription",
 			}
 		);
+
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("AssetRegistry");
+		}
     }
 }
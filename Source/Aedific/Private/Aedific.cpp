@@ -3,5 +3,7 @@
 #include "Aedific.h"
 
 #include <Modules/ModuleManager.h>
+
+DEFINE_LOG_CATEGORY(LogAedific);
 	
 IMPLEMENT_MODULE(FDefaultModuleImpl, Aedific)
@@ -0,0 +1,28 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificContinuumChunk.h"
+
+#include <Components/StaticMeshComponent.h>
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AedificContinuumChunk)
+
+AAedificContinuumChunk::AAedificContinuumChunk()
+{
+	// Set default values for AActor interface members.
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	PrimaryActorTick.bCanEverTick = false;
+
+	// Set default values for this class members.
+#if WITH_EDITORONLY_DATA
+	FirstSegment = 0;
+	NumSegments = 0;
+#endif // WITH_EDITORONLY_DATA
+
+	// Create mesh component.
+	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComponent"));
+	RootComponent = MeshComponent;
+	MeshComponent->SetMobility(EComponentMobility::Static);
+	MeshComponent->SetComponentTickEnabled(false);
+	MeshComponent->SetGenerateOverlapEvents(false);
+	MeshComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndProbe);
+}
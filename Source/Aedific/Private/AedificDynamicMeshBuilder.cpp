@@ -0,0 +1,180 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificDynamicMeshBuilder.h"
+#include "Aedific.h"
+#include "AedificMeshBaker.h"
+
+#include <Async/ParallelFor.h>
+#include <DynamicMesh/DynamicMeshAttributeSet.h>
+#include <Engine/StaticMesh.h>
+#include <ProfilingDebugging/CpuProfilerTrace.h>
+#include <StaticMeshResources.h>
+
+using namespace UE::Geometry;
+
+/** Distance in alpha under which a vertex is considered to lay on the segment's start seam. */
+static constexpr float WeldTolerance = 1.e-3f;
+
+TSharedPtr<const FAedificDynamicMeshSource> FAedificDynamicMeshBuilder::ExtractSource(const UStaticMesh* Mesh)
+{
+	check(IsInGameThread());
+
+	const FStaticMeshRenderData* RenderData = Mesh ? Mesh->GetRenderData() : nullptr;
+	if (!RenderData || RenderData->LODResources.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	const FStaticMeshLODResources& LODResources = RenderData->LODResources[0];
+	const FPositionVertexBuffer& PositionBuffer = LODResources.VertexBuffers.PositionVertexBuffer;
+	const FStaticMeshVertexBuffer& VertexBuffer = LODResources.VertexBuffers.StaticMeshVertexBuffer;
+
+	// Cooked builds drop the CPU copy of the render data once it's uploaded, unless the mesh asks to keep it.
+	if (!PositionBuffer.GetVertexData() || !VertexBuffer.GetTangentData() || !VertexBuffer.GetTexCoordData() || LODResources.IndexBuffer.GetNumIndices() == 0)
+	{
+		UE_LOG(LogAedific, Warning, TEXT("Can't read the geometry of %s, enable Allow CPU Access on the mesh to use it with the dynamic output."), *Mesh->GetName());
+		return nullptr;
+	}
+
+	TSharedPtr<FAedificDynamicMeshSource> Source = MakeShared<FAedificDynamicMeshSource>();
+
+	// Spline mesh components map the mesh bounds along X to the segment.
+	const FBox Bounds = Mesh->GetBoundingBox();
+	Source->MinX = (float)Bounds.Min.X;
+	Source->MeshLength = (float)Bounds.GetSize().X;
+
+	const int32 NumVertices = PositionBuffer.GetNumVertices();
+	Source->Positions.SetNumUninitialized(NumVertices);
+	Source->Normals.SetNumUninitialized(NumVertices);
+	Source->Tangents.SetNumUninitialized(NumVertices);
+	Source->BinormalSigns.SetNumUninitialized(NumVertices);
+	Source->UVs.SetNumUninitialized(NumVertices);
+
+	for (int32 i = 0; i < NumVertices; ++i)
+	{
+		const FVector4f TangentZ = VertexBuffer.VertexTangentZ(i);
+
+		Source->Positions[i] = PositionBuffer.VertexPosition(i);
+		Source->Normals[i] = FVector3f(TangentZ);
+		Source->Tangents[i] = FVector3f(VertexBuffer.VertexTangentX(i));
+		Source->BinormalSigns[i] = (TangentZ.W < 0.f) ? -1.f : 1.f;
+		Source->UVs[i] = VertexBuffer.GetVertexUV(i, 0);
+	}
+
+	TArray<uint32> Indices;
+	LODResources.IndexBuffer.GetCopy(Indices);
+
+	Source->Indices.Reserve(Indices.Num());
+	Source->MaterialIDs.Reserve(Indices.Num() / 3);
+
+	for (const FStaticMeshSection& Section : LODResources.Sections)
+	{
+		for (uint32 Triangle = 0; Triangle < Section.NumTriangles; ++Triangle)
+		{
+			const uint32 FirstIndex = Section.FirstIndex + Triangle * 3;
+			Source->Indices.Add((int32)Indices[FirstIndex]);
+			Source->Indices.Add((int32)Indices[FirstIndex + 1]);
+			Source->Indices.Add((int32)Indices[FirstIndex + 2]);
+			Source->MaterialIDs.Add(Section.MaterialIndex);
+		}
+	}
+
+	return Source;
+}
+
+void FAedificDynamicMeshBuilder::BuildChunk(const FAedificDynamicMeshSource& Source, FAedificDynamicMeshChunk& Chunk)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::BuildDynamicMeshChunk);
+
+	FDynamicMesh3& Mesh = Chunk.Mesh;
+	Mesh.Clear();
+	Mesh.EnableAttributes();
+
+	FDynamicMeshAttributeSet* Attributes = Mesh.Attributes();
+	Attributes->SetNumUVLayers(1);
+	Attributes->EnableTangents();
+	Attributes->EnableMaterialID();
+
+	FDynamicMeshUVOverlay* UVOverlay = Attributes->GetUVLayer(0);
+	FDynamicMeshNormalOverlay* NormalOverlay = Attributes->PrimaryNormals();
+	FDynamicMeshNormalOverlay* TangentOverlay = Attributes->PrimaryTangents();
+	FDynamicMeshNormalOverlay* BinormalOverlay = Attributes->PrimaryBiTangents();
+	FDynamicMeshMaterialAttribute* MaterialIDs = Attributes->GetMaterialID();
+
+	if (Source.MeshLength <= KINDA_SMALL_NUMBER)
+	{
+		return;
+	}
+
+	const int32 NumVertices = Source.Positions.Num();
+	const int32 NumTriangles = Source.MaterialIDs.Num();
+
+	for (int32 SegmentIndex = 0; SegmentIndex < Chunk.Segments.Num(); ++SegmentIndex)
+	{
+		const FAedificMeshSegment& Segment = Chunk.Segments[SegmentIndex];
+		const FAedificMeshSegment* PreviousSegment = (SegmentIndex > 0) ? &Chunk.Segments[SegmentIndex - 1] : (Chunk.bHasPreviousSegment ? &Chunk.PreviousSegment : nullptr);
+
+		// Every overlay gets one element per vertex, the triangles of each segment are offset by these.
+		const int32 VertexBase = Mesh.MaxVertexID();
+		const int32 ElementBase = NormalOverlay->MaxElementID();
+
+		for (int32 i = 0; i < NumVertices; ++i)
+		{
+			const FVector3f& Position = Source.Positions[i];
+			const float Alpha = (Position.X - Source.MinX) / Source.MeshLength;
+
+			// Vertices on the start seam take the previous segment's end slice, so both sides match exactly.
+			const bool bWeld = PreviousSegment && FMath::IsNearlyZero(Alpha, WeldTolerance);
+			const FTransform SliceTransform = bWeld ? FAedificMeshBaker::CalcSliceTransform(*PreviousSegment, 1.f) : FAedificMeshBaker::CalcSliceTransform(Segment, Alpha);
+			const FVector InverseScale = FTransform::GetSafeScaleReciprocal(SliceTransform.GetScale3D());
+
+			const FVector Normal = SliceTransform.TransformVectorNoScale(FVector(Source.Normals[i]) * InverseScale).GetSafeNormal();
+			const FVector Tangent = SliceTransform.TransformVectorNoScale(FVector(Source.Tangents[i])).GetSafeNormal();
+			const FVector Binormal = FVector::CrossProduct(Normal, Tangent) * Source.BinormalSigns[i];
+
+			Mesh.AppendVertex(SliceTransform.TransformPosition(FVector(0.f, Position.Y, Position.Z)));
+			UVOverlay->AppendElement(Source.UVs[i]);
+			NormalOverlay->AppendElement(FVector3f(Normal));
+			TangentOverlay->AppendElement(FVector3f(Tangent));
+			BinormalOverlay->AppendElement(FVector3f(Binormal));
+		}
+
+		for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+		{
+			const int32 A = Source.Indices[Triangle * 3];
+			const int32 B = Source.Indices[Triangle * 3 + 1];
+			const int32 C = Source.Indices[Triangle * 3 + 2];
+
+			// Degenerate and non-manifold triangles of the render mesh are dropped.
+			const int32 TriangleID = Mesh.AppendTriangle(FIndex3i(VertexBase + A, VertexBase + B, VertexBase + C));
+			if (TriangleID < 0)
+			{
+				continue;
+			}
+
+			const FIndex3i Elements(ElementBase + A, ElementBase + B, ElementBase + C);
+			UVOverlay->SetTriangle(TriangleID, Elements);
+			NormalOverlay->SetTriangle(TriangleID, Elements);
+			TangentOverlay->SetTriangle(TriangleID, Elements);
+			BinormalOverlay->SetTriangle(TriangleID, Elements);
+			MaterialIDs->SetValue(TriangleID, Source.MaterialIDs[Triangle]);
+		}
+	}
+}
+
+void FAedificDynamicMeshBuilder::Build(FAedificDynamicMeshBuild& Build)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::BuildDynamicMesh);
+
+	if (!Build.Source.IsValid())
+	{
+		return;
+	}
+
+	const FAedificDynamicMeshSource& Source = *Build.Source;
+
+	ParallelFor(Build.Chunks.Num(), [&](int32 i)
+	{
+		BuildChunk(Source, Build.Chunks[i]);
+	});
+}
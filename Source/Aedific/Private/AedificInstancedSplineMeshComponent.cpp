@@ -0,0 +1,172 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificInstancedSplineMeshComponent.h"
+#include "Aedific.h"
+#include "AedificMeshBaker.h"
+#include "AedificSplineTypes.h"
+
+#include <Algo/AllOf.h>
+#include <Engine/StaticMesh.h>
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AedificInstancedSplineMeshComponent)
+
+/** Amount of slices sampled along a segment to bound it. */
+static constexpr int32 BoundsSteps = 8;
+
+static void WriteVector(TArrayView<float> Record, const int32 Offset, const FVector& Vector)
+{
+	Record[Offset + 0] = (float)Vector.X;
+	Record[Offset + 1] = (float)Vector.Y;
+	Record[Offset + 2] = (float)Vector.Z;
+}
+
+static FVector ReadVector(TConstArrayView<float> Record, const int32 Offset)
+{
+	return FVector(Record[Offset + 0], Record[Offset + 1], Record[Offset + 2]);
+}
+
+UAedificInstancedSplineMeshComponent::UAedificInstancedSplineMeshComponent()
+{
+	// Set default values for UActorComponent interface members.
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.bCanEverTick = false;
+
+	// Set default values for UPrimitiveComponent interface members.
+	// Instances only carry bounding transforms, collision would not match the deformed mesh.
+	Mobility = EComponentMobility::Static;
+	SetGenerateOverlapEvents(false);
+	SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// Set default values for UInstancedStaticMeshComponent interface members.
+	NumCustomDataFloats = RecordSize;
+}
+
+void UAedificInstancedSplineMeshComponent::PackSegment(const FAedificMeshSegment& Segment, const FBox& MeshBounds, TArrayView<float> OutRecord, FTransform& OutInstanceTransform)
+{
+	check(OutRecord.Num() == RecordSize);
+
+	// Bound the deformed segment by sweeping the mesh's cross-section along it.
+	FBox SegmentBounds(ForceInit);
+	for (int32 Step = 0; Step <= BoundsSteps; ++Step)
+	{
+		const FTransform SliceTransform = FAedificMeshBaker::CalcSliceTransform(Segment, (float)Step / (float)BoundsSteps);
+		SegmentBounds += SliceTransform.TransformPosition(FVector(0.f, MeshBounds.Min.Y, MeshBounds.Min.Z));
+		SegmentBounds += SliceTransform.TransformPosition(FVector(0.f, MeshBounds.Min.Y, MeshBounds.Max.Z));
+		SegmentBounds += SliceTransform.TransformPosition(FVector(0.f, MeshBounds.Max.Y, MeshBounds.Min.Z));
+		SegmentBounds += SliceTransform.TransformPosition(FVector(0.f, MeshBounds.Max.Y, MeshBounds.Max.Z));
+	}
+
+	// The curve can bulge slightly between the sampled slices.
+	SegmentBounds = SegmentBounds.ExpandBy(SegmentBounds.GetSize().GetMax() / (float)BoundsSteps);
+
+	// The instance transform maps the mesh bounds onto the segment bounds.
+	const FVector MeshSize = MeshBounds.GetSize().ComponentMax(FVector(KINDA_SMALL_NUMBER));
+	const FVector InstanceScale = SegmentBounds.GetSize().ComponentMax(FVector(KINDA_SMALL_NUMBER)) / MeshSize;
+	const FVector InstanceOrigin = SegmentBounds.Min - InstanceScale * MeshBounds.Min;
+	OutInstanceTransform = FTransform(FQuat::Identity, InstanceOrigin, InstanceScale);
+
+	WriteVector(OutRecord, StartLocationOffset, Segment.StartLocation);
+	WriteVector(OutRecord, StartTangentOffset, Segment.StartTangent);
+	WriteVector(OutRecord, EndLocationOffset, Segment.EndLocation);
+	WriteVector(OutRecord, EndTangentOffset, Segment.EndTangent);
+	WriteVector(OutRecord, UpVectorOffset, Segment.UpVector);
+	OutRecord[StartRollOffset] = FMath::DegreesToRadians(Segment.StartRollDegrees);
+	OutRecord[EndRollOffset] = FMath::DegreesToRadians(Segment.EndRollDegrees);
+	OutRecord[StartScaleOffset] = (float)Segment.StartScale.X;
+	OutRecord[StartScaleOffset + 1] = (float)Segment.StartScale.Y;
+	OutRecord[EndScaleOffset] = (float)Segment.EndScale.X;
+	OutRecord[EndScaleOffset + 1] = (float)Segment.EndScale.Y;
+	WriteVector(OutRecord, InstanceOriginOffset, InstanceOrigin);
+	WriteVector(OutRecord, InstanceScaleOffset, InstanceScale);
+	OutRecord[MeshMinXOffset] = (float)MeshBounds.Min.X;
+	OutRecord[MeshLengthOffset] = (float)MeshSize.X;
+}
+
+FAedificMeshSegment UAedificInstancedSplineMeshComponent::UnpackSegment(TConstArrayView<float> Record)
+{
+	check(Record.Num() == RecordSize);
+
+	FAedificMeshSegment Segment;
+	Segment.StartLocation		= ReadVector(Record, StartLocationOffset);
+	Segment.StartTangent		= ReadVector(Record, StartTangentOffset);
+	Segment.EndLocation			= ReadVector(Record, EndLocationOffset);
+	Segment.EndTangent			= ReadVector(Record, EndTangentOffset);
+	Segment.UpVector			= ReadVector(Record, UpVectorOffset);
+	Segment.StartRollDegrees	= FMath::RadiansToDegrees(Record[StartRollOffset]);
+	Segment.EndRollDegrees		= FMath::RadiansToDegrees(Record[EndRollOffset]);
+	Segment.StartScale			= FVector2D(Record[StartScaleOffset], Record[StartScaleOffset + 1]);
+	Segment.EndScale			= FVector2D(Record[EndScaleOffset], Record[EndScaleOffset + 1]);
+
+	return Segment;
+}
+
+void UAedificInstancedSplineMeshComponent::SetSegment(const int32 Index, const FAedificMeshSegment& Segment)
+{
+	if (!GetStaticMesh())
+	{
+		return;
+	}
+
+	float Record[RecordSize];
+	FTransform InstanceTransform;
+	PackSegment(Segment, GetStaticMesh()->GetBoundingBox(), MakeArrayView(Record), InstanceTransform);
+
+	if (Index >= GetInstanceCount())
+	{
+		check(Index == GetInstanceCount());
+		AddInstance(InstanceTransform, false);
+	}
+	else
+	{
+		UpdateInstanceTransform(Index, InstanceTransform, false, false, true);
+	}
+
+	SetCustomData(Index, MakeArrayView(Record), false);
+}
+
+void UAedificInstancedSplineMeshComponent::TruncateSegments(const int32 Index)
+{
+	for (int32 i = GetInstanceCount() - 1; i >= FMath::Max(Index, 0); --i)
+	{
+		RemoveInstance(i);
+	}
+}
+
+bool UAedificInstancedSplineMeshComponent::ValidateSegments(TConstArrayView<FAedificMeshSegment> Segments) const
+{
+	if (NumCustomDataFloats != RecordSize || GetInstanceCount() != Segments.Num() || PerInstanceSMCustomData.Num() != Segments.Num() * RecordSize)
+	{
+		UE_LOG(LogAedific, Warning, TEXT("%s: Expected %d records of %d floats, found %d instances with %d floats each."),
+			*GetName(), Segments.Num(), RecordSize, GetInstanceCount(), NumCustomDataFloats);
+		return false;
+	}
+
+	const FBox MeshBounds = GetStaticMesh() ? GetStaticMesh()->GetBoundingBox() : FBox(ForceInit);
+
+	for (int32 i = 0; i < Segments.Num(); ++i)
+	{
+		const TConstArrayView<float> Record = MakeArrayView(PerInstanceSMCustomData).Slice(i * RecordSize, RecordSize);
+
+		const bool bFinite = Algo::AllOf(Record, [](const float Value) { return FMath::IsFinite(Value); });
+		if (!bFinite || !UnpackSegment(Record).Equals(Segments[i], KINDA_SMALL_NUMBER * 100.f))
+		{
+			UE_LOG(LogAedific, Warning, TEXT("%s: Record %d doesn't match its segment."), *GetName(), i);
+			return false;
+		}
+
+		// The instance must bound the segment it displays.
+		float ExpectedRecord[RecordSize];
+		FTransform ExpectedTransform;
+		PackSegment(Segments[i], MeshBounds, MakeArrayView(ExpectedRecord), ExpectedTransform);
+
+		FTransform InstanceTransform;
+		GetInstanceTransform(i, InstanceTransform, false);
+		if (!InstanceTransform.Equals(ExpectedTransform, KINDA_SMALL_NUMBER * 100.f))
+		{
+			UE_LOG(LogAedific, Warning, TEXT("%s: Instance %d doesn't bound its segment."), *GetName(), i);
+			return false;
+		}
+	}
+
+	return true;
+}
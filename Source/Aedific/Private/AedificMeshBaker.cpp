@@ -0,0 +1,173 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificMeshBaker.h"
+
+#if WITH_EDITOR
+#include <Async/ParallelFor.h>
+#include <Engine/StaticMesh.h>
+#include <PhysicsEngine/BodySetup.h>
+#include <StaticMeshAttributes.h>
+#include <StaticMeshOperations.h>
+#endif // WITH_EDITOR
+
+FTransform FAedificMeshBaker::CalcSliceTransform(const FAedificMeshSegment& Segment, const float Alpha)
+{
+	// Position and direction follow the segment's cubic Hermite curve.
+	const FVector SplinePos = FMath::CubicInterp(Segment.StartLocation, Segment.StartTangent, Segment.EndLocation, Segment.EndTangent, Alpha);
+	const FVector SplineDir = FMath::CubicInterpDerivative(Segment.StartLocation, Segment.StartTangent, Segment.EndLocation, Segment.EndTangent, Alpha).GetSafeNormal();
+
+	// Base frame around the spline, before the roll is applied.
+	const FVector BaseXVec = FVector::CrossProduct(Segment.UpVector, SplineDir).GetSafeNormal();
+	const FVector BaseYVec = FVector::CrossProduct(SplineDir, BaseXVec).GetSafeNormal();
+
+	// Roll and scale are interpolated linearly, as spline mesh components do without smooth interpolation.
+	const float Roll = FMath::DegreesToRadians(FMath::Lerp(Segment.StartRollDegrees, Segment.EndRollDegrees, Alpha));
+	const float CosAng = FMath::Cos(Roll);
+	const float SinAng = FMath::Sin(Roll);
+	const FVector XVec = (CosAng * BaseXVec) - (SinAng * BaseYVec);
+	const FVector YVec = (CosAng * BaseYVec) + (SinAng * BaseXVec);
+
+	const FVector2D Scale = FMath::Lerp(Segment.StartScale, Segment.EndScale, Alpha);
+
+	FTransform SliceTransform(SplineDir, XVec, YVec, SplinePos);
+	SliceTransform.SetScale3D(FVector(1.f, Scale.X, Scale.Y));
+
+	return SliceTransform;
+}
+
+#if WITH_EDITOR
+/** Distance in alpha under which a vertex is considered to lay on the segment's start seam. */
+static constexpr float WeldTolerance = 1.e-3f;
+
+static void DeformMeshDescription(FMeshDescription& Description, const FAedificMeshSegment& Segment, const FAedificMeshSegment* PreviousSegment, const float MinX, const float MeshLength)
+{
+	FStaticMeshAttributes Attributes(Description);
+	TVertexAttributesRef<FVector3f> Positions = Attributes.GetVertexPositions();
+	TVertexInstanceAttributesRef<FVector3f> Normals = Attributes.GetVertexInstanceNormals();
+	TVertexInstanceAttributesRef<FVector3f> Tangents = Attributes.GetVertexInstanceTangents();
+
+	// Vertex instances are deformed with the slice of their vertex, so keep them around.
+	TArray<FTransform> SliceTransforms;
+	SliceTransforms.SetNum(Description.Vertices().GetArraySize());
+
+	for (const FVertexID VertexID : Description.Vertices().GetElementIDs())
+	{
+		const FVector Position = FVector(Positions[VertexID]);
+		const float Alpha = (Position.X - MinX) / MeshLength;
+
+		// Vertices on the start seam take the previous segment's end slice, so both sides match exactly.
+		const bool bWeld = PreviousSegment && FMath::IsNearlyZero(Alpha, WeldTolerance);
+		const FTransform SliceTransform = bWeld ? FAedificMeshBaker::CalcSliceTransform(*PreviousSegment, 1.f) : FAedificMeshBaker::CalcSliceTransform(Segment, Alpha);
+
+		SliceTransforms[VertexID.GetValue()] = SliceTransform;
+		Positions[VertexID] = FVector3f(SliceTransform.TransformPosition(FVector(0.f, Position.Y, Position.Z)));
+	}
+
+	for (const FVertexInstanceID VertexInstanceID : Description.VertexInstances().GetElementIDs())
+	{
+		const FTransform& SliceTransform = SliceTransforms[Description.GetVertexInstanceVertex(VertexInstanceID).GetValue()];
+		const FVector InverseScale = FTransform::GetSafeScaleReciprocal(SliceTransform.GetScale3D());
+
+		Normals[VertexInstanceID] = FVector3f(SliceTransform.TransformVectorNoScale(FVector(Normals[VertexInstanceID]) * InverseScale).GetSafeNormal());
+		Tangents[VertexInstanceID] = FVector3f(SliceTransform.TransformVectorNoScale(FVector(Tangents[VertexInstanceID])).GetSafeNormal());
+	}
+}
+
+bool FAedificMeshBaker::BakeSegments(UStaticMesh* SourceMesh, TConstArrayView<FAedificMeshSegment> Segments, const FAedificMeshSegment* PreviousSegment, UStaticMesh* TargetMesh)
+{
+	if (!SourceMesh || !TargetMesh || Segments.Num() == 0)
+	{
+		return false;
+	}
+
+	// Spline mesh components map the mesh bounds along X to the segment.
+	const FBox Bounds = SourceMesh->GetBoundingBox();
+	const float MinX = Bounds.Min.X;
+	const float MeshLength = Bounds.GetSize().X;
+
+	if (MeshLength <= KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	const int32 NumLODs = SourceMesh->GetNumSourceModels();
+
+	TargetMesh->PreEditChange(nullptr);
+	TargetMesh->SetNumSourceModels(NumLODs);
+	TargetMesh->SetStaticMaterials(SourceMesh->GetStaticMaterials());
+
+	for (int32 LODIndex = 0; LODIndex < NumLODs; ++LODIndex)
+	{
+		const FStaticMeshSourceModel& SourceModel = SourceMesh->GetSourceModel(LODIndex);
+		FStaticMeshSourceModel& TargetModel = TargetMesh->GetSourceModel(LODIndex);
+		TargetModel.BuildSettings = SourceModel.BuildSettings;
+		TargetModel.ReductionSettings = SourceModel.ReductionSettings;
+		TargetModel.ScreenSize = SourceModel.ScreenSize;
+
+		const FMeshDescription* SourceDescription = SourceMesh->GetMeshDescription(LODIndex);
+		if (!SourceDescription)
+		{
+			// LODs generated by reduction only need their settings, they'll be generated from the baked LOD0.
+			TargetMesh->ClearMeshDescription(LODIndex);
+			continue;
+		}
+
+		// Normals and tangents are already deformed, recomputing them would break the welded seams.
+		TargetModel.BuildSettings.bRecomputeNormals = false;
+		TargetModel.BuildSettings.bRecomputeTangents = false;
+
+		// Deform one copy of the source mesh per segment.
+		TArray<FMeshDescription> SegmentDescriptions;
+		SegmentDescriptions.SetNum(Segments.Num());
+
+		ParallelFor(Segments.Num(), [&](int32 i)
+		{
+			SegmentDescriptions[i] = *SourceDescription;
+			DeformMeshDescription(SegmentDescriptions[i], Segments[i], (i > 0) ? &Segments[i - 1] : PreviousSegment, MinX, MeshLength);
+		});
+
+		// Merge them into the LOD, keeping the source's polygon groups so each material stays a single section.
+		FMeshDescription* TargetDescription = TargetMesh->CreateMeshDescription(LODIndex);
+		FStaticMeshAttributes TargetAttributes(*TargetDescription);
+		TargetAttributes.Register();
+
+		FStaticMeshConstAttributes SourceAttributes(*SourceDescription);
+		TargetAttributes.GetVertexInstanceUVs().SetNumChannels(SourceAttributes.GetVertexInstanceUVs().GetNumChannels());
+
+		for (const FPolygonGroupID PolygonGroupID : SourceDescription->PolygonGroups().GetElementIDs())
+		{
+			TargetDescription->CreatePolygonGroupWithID(PolygonGroupID);
+			TargetAttributes.GetPolygonGroupMaterialSlotNames()[PolygonGroupID] = SourceAttributes.GetPolygonGroupMaterialSlotNames()[PolygonGroupID];
+		}
+
+		FStaticMeshOperations::FAppendSettings AppendSettings;
+		AppendSettings.PolygonGroupsDelegate = FAppendPolygonGroupsDelegate::CreateLambda([](const FMeshDescription& Source, FMeshDescription& Target, PolygonGroupMap& RemapPolygonGroups)
+		{
+			for (const FPolygonGroupID PolygonGroupID : Source.PolygonGroups().GetElementIDs())
+			{
+				RemapPolygonGroups.Add(PolygonGroupID, PolygonGroupID);
+			}
+		});
+
+		TArray<const FMeshDescription*> SourceDescriptions;
+		SourceDescriptions.Reserve(SegmentDescriptions.Num());
+		for (const FMeshDescription& SegmentDescription : SegmentDescriptions)
+		{
+			SourceDescriptions.Add(&SegmentDescription);
+		}
+
+		FStaticMeshOperations::AppendMeshDescriptions(SourceDescriptions, *TargetDescription, AppendSettings);
+
+		TargetMesh->CommitMeshDescription(LODIndex);
+	}
+
+	// Collision uses the baked triangles, the deformed surface can't be approximated by simple shapes.
+	TargetMesh->CreateBodySetup();
+	TargetMesh->GetBodySetup()->CollisionTraceFlag = ECollisionTraceFlag::CTF_UseComplexAsSimple;
+
+	TargetMesh->Build(true);
+	TargetMesh->PostEditChange();
+
+	return true;
+}
+#endif // WITH_EDITOR
@@ -0,0 +1,538 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificRebuildSubsystem.h"
+#include "Aedific.h"
+#include "AedificSplineContinuum.h"
+
+#include <Components/SplineComponent.h>
+#include <EngineUtils.h>
+#include <GameFramework/PlayerController.h>
+#include <HAL/IConsoleManager.h>
+#include <ProfilingDebugging/CountersTrace.h>
+#include <ProfilingDebugging/CpuProfilerTrace.h>
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AedificRebuildSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("Rebuild Scheduler"), STAT_AedificRebuildScheduler, STATGROUP_Aedific);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Materialized Segments"), STAT_AedificMaterializedSegments, STATGROUP_Aedific);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Rebuilds"), STAT_AedificQueuedRebuilds, STATGROUP_Aedific);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Queued Materializations"), STAT_AedificQueuedMaterializations, STATGROUP_Aedific);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Components Alive"), STAT_AedificComponentsAlive, STATGROUP_Aedific);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last Rebuild Latency (ms)"), STAT_AedificRebuildLatency, STATGROUP_Aedific);
+
+TRACE_DECLARE_INT_COUNTER(AedificMaterializedSegments, TEXT("Aedific/Materialized Segments"));
+TRACE_DECLARE_INT_COUNTER(AedificQueuedRebuilds, TEXT("Aedific/Queued Rebuilds"));
+TRACE_DECLARE_INT_COUNTER(AedificQueuedMaterializations, TEXT("Aedific/Queued Materializations"));
+TRACE_DECLARE_INT_COUNTER(AedificComponentsAlive, TEXT("Aedific/Components Alive"));
+TRACE_DECLARE_FLOAT_COUNTER(AedificRebuildLatency, TEXT("Aedific/Last Rebuild Latency (ms)"));
+
+static TAutoConsoleVariable<float> CVarAedificRebuildBudget(
+	TEXT("Aedific.RebuildBudgetMs"),
+	2.f,
+	TEXT("Time in milliseconds the continuums of a world may spend starting rebuilds and applying generated segments each frame. 0 disables the budget."));
+
+static TAutoConsoleVariable<float> CVarAedificVirtualizationInterval(
+	TEXT("Aedific.VirtualizationInterval"),
+	0.2f,
+	TEXT("Time in seconds between two updates of the segments given a component around the viewers and players, for continuums virtualizing their segments."));
+
+#if WITH_EDITOR
+static TAutoConsoleVariable<float> CVarAedificPreviewSettleTime(
+	TEXT("Aedific.PreviewSettleTime"),
+	0.5f,
+	TEXT("Time in seconds without changes after which an interactive edit is considered over, and the preview replaced with a full rebuild."));
+#endif // WITH_EDITOR
+
+void UAedificRebuildSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	NextVirtualizationTime = 0.0;
+
+#if WITH_EDITOR
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &UAedificRebuildSubsystem::OnObjectPropertyChanged);
+#endif // WITH_EDITOR
+}
+
+void UAedificRebuildSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+#endif // WITH_EDITOR
+
+	Super::Deinitialize();
+}
+
+void UAedificRebuildSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::RebuildScheduler);
+	SCOPE_CYCLE_COUNTER(STAT_AedificRebuildScheduler);
+
+	// Counting components walks every continuum, only do it when stats or counters are being recorded.
+	bool bRecordCounters = false;
+#if STATS
+	bRecordCounters |= FThreadStats::IsCollectingData();
+#endif // STATS
+#if COUNTERSTRACE_ENABLED
+	bRecordCounters |= UE_TRACE_CHANNELEXPR_IS_ENABLED(CountersChannel);
+#endif // COUNTERSTRACE_ENABLED
+
+	if (bRecordCounters)
+	{
+		int32 NumComponents = 0;
+		int32 NumMaterialized = 0;
+		for (TActorIterator<AAedificSplineContinuum> It(GetWorld()); It; ++It)
+		{
+			NumComponents += It->GetNumSplineMeshComponents();
+			NumMaterialized += It->GetNumMaterializedSegments();
+		}
+
+		SET_DWORD_STAT(STAT_AedificComponentsAlive, NumComponents);
+		SET_DWORD_STAT(STAT_AedificMaterializedSegments, NumMaterialized);
+		SET_DWORD_STAT(STAT_AedificQueuedRebuilds, RebuildQueue.Num());
+		SET_DWORD_STAT(STAT_AedificQueuedMaterializations, MaterializationQueue.Num());
+
+		TRACE_COUNTER_SET(AedificComponentsAlive, NumComponents);
+		TRACE_COUNTER_SET(AedificMaterializedSegments, NumMaterialized);
+		TRACE_COUNTER_SET(AedificQueuedRebuilds, RebuildQueue.Num());
+		TRACE_COUNTER_SET(AedificQueuedMaterializations, MaterializationQueue.Num());
+	}
+
+#if WITH_EDITOR
+	SettleInteractiveEdits();
+#endif // WITH_EDITOR
+
+	const float BudgetMs = CVarAedificRebuildBudget.GetValueOnGameThread();
+	const double EndTime = (BudgetMs > 0.f) ? FPlatformTime::Seconds() + BudgetMs / 1000.0 : 0.0;
+
+	auto IsOverBudget = [EndTime]() { return EndTime > 0.0 && FPlatformTime::Seconds() >= EndTime; };
+
+	// Finished builds go first, their segments are the closest to being displayed.
+	for (int32 i = 0; i < MaterializationQueue.Num() && !IsOverBudget();)
+	{
+		AAedificSplineContinuum* Continuum = MaterializationQueue[i].Get();
+		if (!Continuum || Continuum->MaterializeSegments(EndTime))
+		{
+			MaterializationQueue.RemoveAt(i, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		++i;
+	}
+
+	UpdateVirtualization(EndTime);
+
+	if (RebuildQueue.Num() == 0)
+	{
+		return;
+	}
+
+	SortRebuildQueue();
+
+	// At least one rebuild starts every frame, so the queue always drains.
+	int32 NumStarted = 0;
+	while (NumStarted < RebuildQueue.Num() && (NumStarted == 0 || !IsOverBudget()))
+	{
+		if (AAedificSplineContinuum* Continuum = RebuildQueue[NumStarted].Get())
+		{
+			Continuum->StartRebuild();
+		}
+
+		++NumStarted;
+	}
+
+	RebuildQueue.RemoveAt(0, NumStarted, EAllowShrinking::No);
+}
+
+TStatId UAedificRebuildSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAedificRebuildSubsystem, STATGROUP_Tickables);
+}
+
+void UAedificRebuildSubsystem::RequestRebuild(AAedificSplineContinuum* Continuum)
+{
+	++Stats.NumRequests;
+
+	if (RebuildQueue.Contains(Continuum))
+	{
+		++Stats.NumDeduplicated;
+		return;
+	}
+
+	RebuildQueue.Add(Continuum);
+
+	// Latency is measured from the oldest request still unfinished.
+	if (!RequestTimes.Contains(Continuum))
+	{
+		RequestTimes.Add(Continuum, FPlatformTime::Seconds());
+	}
+}
+
+void UAedificRebuildSubsystem::RequestMaterialization(AAedificSplineContinuum* Continuum)
+{
+	MaterializationQueue.AddUnique(Continuum);
+}
+
+double UAedificRebuildSubsystem::NotifyRebuildFinished(AAedificSplineContinuum* Continuum)
+{
+	double RequestTime;
+	if (!RequestTimes.RemoveAndCopyValue(Continuum, RequestTime))
+	{
+		return 0.0;
+	}
+
+	const double Latency = FPlatformTime::Seconds() - RequestTime;
+
+	++Stats.NumCompleted;
+	Stats.TotalLatency += Latency;
+	Stats.MaxLatency = FMath::Max(Stats.MaxLatency, Latency);
+
+	SET_FLOAT_STAT(STAT_AedificRebuildLatency, Latency * 1000.0);
+	TRACE_COUNTER_SET(AedificRebuildLatency, Latency * 1000.0);
+
+	return Latency;
+}
+
+void UAedificRebuildSubsystem::NotifyRebuildCancelled(AAedificSplineContinuum* Continuum)
+{
+	RequestTimes.Remove(Continuum);
+}
+
+#if WITH_EDITOR
+void UAedificRebuildSubsystem::NotifyInteractiveEdit(AAedificSplineContinuum* Continuum)
+{
+	InteractiveEdits.AddUnique(Continuum);
+}
+
+void UAedificRebuildSubsystem::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	const USplineComponent* Spline = Cast<USplineComponent>(Object);
+	if (!Spline || Spline->GetWorld() != GetWorld())
+	{
+		return;
+	}
+
+	if (AAedificSplineContinuum* Continuum = Cast<AAedificSplineContinuum>(Spline->GetOwner()))
+	{
+		Continuum->NotifyEdited(PropertyChangedEvent.ChangeType == EPropertyChangeType::Interactive);
+	}
+}
+
+void UAedificRebuildSubsystem::SettleInteractiveEdits()
+{
+	const double SettleTime = FPlatformTime::Seconds() - CVarAedificPreviewSettleTime.GetValueOnGameThread();
+
+	for (int32 i = InteractiveEdits.Num() - 1; i >= 0; --i)
+	{
+		AAedificSplineContinuum* Continuum = InteractiveEdits[i].Get();
+		if (!Continuum || !Continuum->IsInteractivelyEdited())
+		{
+			InteractiveEdits.RemoveAtSwap(i);
+		}
+		else if (Continuum->GetLastInteractiveEditTime() < SettleTime)
+		{
+			InteractiveEdits.RemoveAtSwap(i);
+			Continuum->NotifyEdited(false);
+		}
+	}
+}
+#endif // WITH_EDITOR
+
+void UAedificRebuildSubsystem::RegisterVirtualizedContinuum(AAedificSplineContinuum* Continuum)
+{
+	VirtualizedContinuums.AddUnique(Continuum);
+}
+
+void UAedificRebuildSubsystem::UnregisterVirtualizedContinuum(AAedificSplineContinuum* Continuum)
+{
+	VirtualizedContinuums.RemoveSwap(Continuum);
+}
+
+int32 UAedificRebuildSubsystem::RebuildAllDirty()
+{
+	int32 NumDirty = 0;
+
+	for (TActorIterator<AAedificSplineContinuum> It(GetWorld()); It; ++It)
+	{
+		if (It->IsBuildOutdated())
+		{
+			It->RebuildMesh();
+			++NumDirty;
+		}
+	}
+
+	return NumDirty;
+}
+
+FAedificRebuildStats UAedificRebuildSubsystem::GetStats() const
+{
+	FAedificRebuildStats CurrentStats = Stats;
+	CurrentStats.QueuedRebuilds = RebuildQueue.Num();
+	CurrentStats.QueuedMaterializations = MaterializationQueue.Num();
+
+	return CurrentStats;
+}
+
+void UAedificRebuildSubsystem::ResetStats()
+{
+	Stats = FAedificRebuildStats();
+}
+
+void UAedificRebuildSubsystem::SortRebuildQueue()
+{
+	const TArray<FVector>& ViewLocations = GetWorld()->ViewLocationsRenderedLastFrame;
+
+	struct FCandidate
+	{
+		TWeakObjectPtr<AAedificSplineContinuum> Continuum;
+		bool bVisible;
+		double ViewDistanceSquared;
+	};
+
+	TArray<FCandidate> Candidates;
+	Candidates.Reserve(RebuildQueue.Num());
+
+	for (const TWeakObjectPtr<AAedificSplineContinuum>& WeakContinuum : RebuildQueue)
+	{
+		const AAedificSplineContinuum* Continuum = WeakContinuum.Get();
+		if (!Continuum)
+		{
+			continue;
+		}
+
+		FCandidate& Candidate = Candidates.AddDefaulted_GetRef();
+		Candidate.Continuum = WeakContinuum;
+		Candidate.bVisible = Continuum->WasRecentlyRendered();
+		Candidate.ViewDistanceSquared = 0.0;
+
+		if (const USplineComponent* Spline = Continuum->GetSplineComponent(); Spline && ViewLocations.Num() > 0)
+		{
+			const FBox Bounds = Spline->Bounds.GetBox();
+
+			Candidate.ViewDistanceSquared = MAX_dbl;
+			for (const FVector& ViewLocation : ViewLocations)
+			{
+				Candidate.ViewDistanceSquared = FMath::Min(Candidate.ViewDistanceSquared, Bounds.ComputeSquaredDistanceToPoint(ViewLocation));
+			}
+		}
+	}
+
+	Candidates.StableSort([](const FCandidate& A, const FCandidate& B)
+	{
+		if (A.bVisible != B.bVisible)
+		{
+			return A.bVisible;
+		}
+
+		return A.ViewDistanceSquared < B.ViewDistanceSquared;
+	});
+
+	RebuildQueue.Reset(Candidates.Num());
+	for (const FCandidate& Candidate : Candidates)
+	{
+		RebuildQueue.Add(Candidate.Continuum);
+	}
+}
+
+void UAedificRebuildSubsystem::UpdateVirtualization(const double EndTime)
+{
+	if (VirtualizedContinuums.Num() == 0)
+	{
+		return;
+	}
+
+	// Every continuum is updated once the interval elapsed, in-between only the ones whose segments changed.
+	const double CurrentTime = FPlatformTime::Seconds();
+	const bool bIntervalElapsed = CurrentTime >= NextVirtualizationTime;
+
+	if (bIntervalElapsed)
+	{
+		NextVirtualizationTime = CurrentTime + FMath::Max(CVarAedificVirtualizationInterval.GetValueOnGameThread(), 0.f);
+	}
+
+	TArray<FVector> Sources;
+	bool bSourcesGathered = false;
+
+	for (int32 i = VirtualizedContinuums.Num() - 1; i >= 0; --i)
+	{
+		AAedificSplineContinuum* Continuum = VirtualizedContinuums[i].Get();
+		if (!Continuum)
+		{
+			VirtualizedContinuums.RemoveAtSwap(i);
+			continue;
+		}
+
+		if (!bIntervalElapsed && !Continuum->IsVirtualizationUpdateRequested())
+		{
+			continue;
+		}
+
+		if (!bSourcesGathered)
+		{
+			GatherVirtualizationSources(Sources);
+			bSourcesGathered = true;
+		}
+
+		Continuum->UpdateVirtualization(Sources, EndTime);
+	}
+}
+
+void UAedificRebuildSubsystem::GatherVirtualizationSources(TArray<FVector>& OutSources) const
+{
+	const UWorld* World = GetWorld();
+	OutSources.Append(World->ViewLocationsRenderedLastFrame);
+
+	// Players are sources even when they don't render, such as on dedicated servers, so their collision stays around them.
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PlayerController = It->Get())
+		{
+			FVector Location;
+			FRotator Rotation;
+			PlayerController->GetPlayerViewPoint(Location, Rotation);
+
+			OutSources.AddUnique(Location);
+		}
+	}
+}
+
+static void RebuildAllDirty(UWorld* World)
+{
+	if (UAedificRebuildSubsystem* Subsystem = World ? World->GetSubsystem<UAedificRebuildSubsystem>() : nullptr)
+	{
+		UE_LOG(LogAedific, Display, TEXT("Queued %d outdated continuums for rebuild."), Subsystem->RebuildAllDirty());
+	}
+}
+
+static void DumpRebuildStats(UWorld* World)
+{
+	if (UAedificRebuildSubsystem* Subsystem = World ? World->GetSubsystem<UAedificRebuildSubsystem>() : nullptr)
+	{
+		const FAedificRebuildStats Stats = Subsystem->GetStats();
+
+		UE_LOG(LogAedific, Display, TEXT("Rebuilds queued: %d, materializing: %d, requests: %u (%u merged), completed: %u, avoided: %u, latency avg: %.1f ms, max: %.1f ms."),
+			Stats.QueuedRebuilds, Stats.QueuedMaterializations, Stats.NumRequests, Stats.NumDeduplicated, Stats.NumCompleted, Stats.NumAvoided,
+			Stats.GetAverageLatency() * 1000.0, Stats.MaxLatency * 1000.0);
+	}
+}
+
+static void DumpContinuums(const TArray<FString>& Args, UWorld* World)
+{
+	if (!World)
+	{
+		return;
+	}
+
+	const int32 MaxCount = (Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 20;
+
+	TArray<const AAedificSplineContinuum*> Continuums;
+	for (TActorIterator<AAedificSplineContinuum> It(World); It; ++It)
+	{
+		Continuums.Add(*It);
+	}
+
+	// The most expensive continuums first.
+	Continuums.Sort([](const AAedificSplineContinuum& A, const AAedificSplineContinuum& B)
+	{
+		return A.GetContinuumStats().GetTotalTime() > B.GetContinuumStats().GetTotalTime();
+	});
+
+	UE_LOG(LogAedific, Display, TEXT("%-40s %9s %9s %9s %9s %9s %9s %9s %11s %11s %11s"),
+		TEXT("Continuum"), TEXT("Segments"), TEXT("Comps"), TEXT("Shown"), TEXT("Rebuilds"), TEXT("Avoided"), TEXT("Applied"), TEXT("Created"), TEXT("Game (ms)"), TEXT("Worker (ms)"), TEXT("Latency (ms)"));
+
+	for (int32 i = 0; i < Continuums.Num() && (MaxCount <= 0 || i < MaxCount); ++i)
+	{
+		const AAedificSplineContinuum* Continuum = Continuums[i];
+		const FAedificContinuumStats& ContinuumStats = Continuum->GetContinuumStats();
+
+		UE_LOG(LogAedific, Display, TEXT("%-40s %9d %9d %9d %9u %9u %9u %9u %11.2f %11.2f %11.2f"),
+			*Continuum->GetActorNameOrLabel(), Continuum->GetNumSegments(), Continuum->GetNumSplineMeshComponents(), Continuum->GetNumMaterializedSegments(),
+			ContinuumStats.NumRebuilds, Continuum->GetAvoidedRebuilds(), ContinuumStats.NumSegmentsApplied, ContinuumStats.NumComponentsCreated,
+			ContinuumStats.GameThreadTime * 1000.0, ContinuumStats.WorkerTime * 1000.0, ContinuumStats.MaxLatency * 1000.0);
+	}
+
+	UE_LOG(LogAedific, Display, TEXT("%d continuums in the world."), Continuums.Num());
+}
+
+static void BenchmarkClusters(const TArray<FString>& Args, UWorld* World)
+{
+	if (!World)
+	{
+		return;
+	}
+
+	const int32 Iterations = FMath::Max((Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 5, 1);
+
+	TArray<AAedificSplineContinuum*> Continuums;
+	int32 NumComponents = 0;
+
+	for (TActorIterator<AAedificSplineContinuum> It(World); It; ++It)
+	{
+		Continuums.Add(*It);
+		NumComponents += It->GetNumSplineMeshComponents();
+	}
+
+	auto MeasureGarbageCollection = [Iterations]()
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		}
+
+		return (FPlatformTime::Seconds() - StartTime) / Iterations;
+	};
+
+	// Measured with the clusters as they are, then with every continuum traversed object by object.
+	int32 NumClustered = 0;
+	for (AAedificSplineContinuum* Continuum : Continuums)
+	{
+		Continuum->CreateComponentCluster();
+		NumClustered += Continuum->IsComponentClusterRoot() ? 1 : 0;
+	}
+
+	const double ClusteredTime = MeasureGarbageCollection();
+
+	for (AAedificSplineContinuum* Continuum : Continuums)
+	{
+		Continuum->DissolveComponentCluster();
+	}
+
+	const double UnclusteredTime = MeasureGarbageCollection();
+
+	for (AAedificSplineContinuum* Continuum : Continuums)
+	{
+		Continuum->CreateComponentCluster();
+	}
+
+	UE_LOG(LogAedific, Display, TEXT("%d continuums, %d spline mesh components, %d clustered. Garbage collection: %.2f ms clustered, %.2f ms unclustered (%d iterations)."),
+		Continuums.Num(), NumComponents, NumClustered, ClusteredTime * 1000.0, UnclusteredTime * 1000.0, Iterations);
+
+	if (NumClustered == 0 && Continuums.Num() > 0)
+	{
+		UE_LOG(LogAedific, Display, TEXT("No continuum could be clustered: clusters are only created in game worlds of cooked builds, with Aedific.ComponentClusters enabled."));
+	}
+}
+
+static FAutoConsoleCommandWithWorld RebuildAllDirtyCommand(
+	TEXT("Aedific.RebuildAllDirty"),
+	TEXT("Queues a rebuild of every continuum whose meshes don't match its spline anymore."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&RebuildAllDirty));
+
+static FAutoConsoleCommandWithWorld DumpRebuildStatsCommand(
+	TEXT("Aedific.RebuildStats"),
+	TEXT("Logs the rebuild queue depths and latencies of the continuums."),
+	FConsoleCommandWithWorldDelegate::CreateStatic(&DumpRebuildStats));
+
+static FAutoConsoleCommandWithWorldAndArgs DumpContinuumsCommand(
+	TEXT("Aedific.DumpContinuums"),
+	TEXT("Logs the rebuild totals of the continuums, the most expensive first. Optional argument: amount of continuums to log, 0 for all (default 20)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&DumpContinuums));
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkClustersCommand(
+	TEXT("Aedific.BenchmarkClusters"),
+	TEXT("Logs the time of a full garbage collection with the continuums' component clusters, then without them. Optional argument: amount of collections to average (default 5)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchmarkClusters));
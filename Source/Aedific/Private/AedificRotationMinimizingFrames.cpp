@@ -0,0 +1,352 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificRotationMinimizingFrames.h"
+#include "Aedific.h"
+
+#include <HAL/IConsoleManager.h>
+
+/** Reflection planes carrying each frame onto the next one, as plane normals and their 2 / |V|^2 factors. */
+struct FAedificReflectionStreams
+{
+	FAedificVectorStreams V1;
+	FAedificVectorStreams V2;
+	TArray<float> K1;
+	TArray<float> K2;
+
+	void SetNumUninitialized(const int32 Num)
+	{
+		V1.SetNumUninitialized(Num);
+		V2.SetNumUninitialized(Num);
+		K1.SetNumUninitialized(Num);
+		K2.SetNumUninitialized(Num);
+	}
+};
+
+/** Squared length under which a reflection plane is degenerate and the reflection skipped. */
+static constexpr float ReflectionThreshold = 1.e-12f;
+
+/** Computes the reflection planes of the interval i, whose offset is already stored in Out.V1. */
+static void ComputeReflection(const FAedificVectorStreams& Tangents, FAedificReflectionStreams& Out, const int32 i)
+{
+	const FVector V1 = Out.V1.Get(i);
+	const float C1 = V1.SizeSquared();
+	const float K1 = (C1 > ReflectionThreshold) ? 2.f / C1 : 0.f;
+
+	const FVector Tangent = Tangents.Get(i);
+	const FVector ReflectedTangent = Tangent - V1 * (K1 * FVector::DotProduct(V1, Tangent));
+
+	const FVector V2 = Tangents.Get(i + 1) - ReflectedTangent;
+	const float C2 = V2.SizeSquared();
+	const float K2 = (C2 > ReflectionThreshold) ? 2.f / C2 : 0.f;
+
+	Out.V2.Set(i, V2);
+	Out.K1[i] = K1;
+	Out.K2[i] = K2;
+}
+
+/** Computes the reflection planes of the intervals [First, Last], four at a time. */
+static void ComputeReflections(TConstArrayView<FVector> Positions, const FAedificVectorStreams& Tangents, FAedificReflectionStreams& Out, const int32 First, const int32 Last)
+{
+	// Offsets between consecutive positions are taken in double, they're small enough for floats once subtracted.
+	for (int32 i = First; i <= Last; ++i)
+	{
+		Out.V1.Set(i, Positions[i + 1] - Positions[i]);
+	}
+
+	const VectorRegister4Float Two = VectorSetFloat1(2.f);
+	const VectorRegister4Float Threshold = VectorSetFloat1(ReflectionThreshold);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+
+	int32 i = First;
+	for (; i + 3 <= Last; i += 4)
+	{
+		const VectorRegister4Float V1X = VectorLoad(Out.V1.X.GetData() + i);
+		const VectorRegister4Float V1Y = VectorLoad(Out.V1.Y.GetData() + i);
+		const VectorRegister4Float V1Z = VectorLoad(Out.V1.Z.GetData() + i);
+
+		const VectorRegister4Float C1 = VectorMultiplyAdd(V1X, V1X, VectorMultiplyAdd(V1Y, V1Y, VectorMultiply(V1Z, V1Z)));
+		const VectorRegister4Float K1 = VectorSelect(VectorCompareGT(C1, Threshold), VectorDivide(Two, C1), Zero);
+
+		const VectorRegister4Float TX = VectorLoad(Tangents.X.GetData() + i);
+		const VectorRegister4Float TY = VectorLoad(Tangents.Y.GetData() + i);
+		const VectorRegister4Float TZ = VectorLoad(Tangents.Z.GetData() + i);
+
+		const VectorRegister4Float Dot1 = VectorMultiply(K1, VectorMultiplyAdd(V1X, TX, VectorMultiplyAdd(V1Y, TY, VectorMultiply(V1Z, TZ))));
+
+		const VectorRegister4Float V2X = VectorSubtract(VectorLoad(Tangents.X.GetData() + i + 1), VectorNegateMultiplyAdd(Dot1, V1X, TX));
+		const VectorRegister4Float V2Y = VectorSubtract(VectorLoad(Tangents.Y.GetData() + i + 1), VectorNegateMultiplyAdd(Dot1, V1Y, TY));
+		const VectorRegister4Float V2Z = VectorSubtract(VectorLoad(Tangents.Z.GetData() + i + 1), VectorNegateMultiplyAdd(Dot1, V1Z, TZ));
+
+		const VectorRegister4Float C2 = VectorMultiplyAdd(V2X, V2X, VectorMultiplyAdd(V2Y, V2Y, VectorMultiply(V2Z, V2Z)));
+		const VectorRegister4Float K2 = VectorSelect(VectorCompareGT(C2, Threshold), VectorDivide(Two, C2), Zero);
+
+		VectorStore(K1, Out.K1.GetData() + i);
+		VectorStore(V2X, Out.V2.X.GetData() + i);
+		VectorStore(V2Y, Out.V2.Y.GetData() + i);
+		VectorStore(V2Z, Out.V2.Z.GetData() + i);
+		VectorStore(K2, Out.K2.GetData() + i);
+	}
+
+	for (; i <= Last; ++i)
+	{
+		ComputeReflection(Tangents, Out, i);
+	}
+}
+
+static void OrthonormalizeNormal(const FAedificVectorStreams& Tangents, FAedificVectorStreams& Normals, const int32 k)
+{
+	const FVector Tangent = Tangents.Get(k);
+	const FVector Normal = Normals.Get(k);
+
+	Normals.Set(k, (Normal - Tangent * FVector::DotProduct(Normal, Tangent)).GetSafeNormal());
+}
+
+/** Makes the normals of the frames [First, Last] orthogonal to their tangent and unit length, four at a time. */
+static void OrthonormalizeNormals(const FAedificVectorStreams& Tangents, FAedificVectorStreams& Normals, const int32 First, const int32 Last)
+{
+	const VectorRegister4Float Threshold = VectorSetFloat1(SMALL_NUMBER);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+
+	int32 k = First;
+	for (; k + 3 <= Last; k += 4)
+	{
+		const VectorRegister4Float TX = VectorLoad(Tangents.X.GetData() + k);
+		const VectorRegister4Float TY = VectorLoad(Tangents.Y.GetData() + k);
+		const VectorRegister4Float TZ = VectorLoad(Tangents.Z.GetData() + k);
+
+		VectorRegister4Float NX = VectorLoad(Normals.X.GetData() + k);
+		VectorRegister4Float NY = VectorLoad(Normals.Y.GetData() + k);
+		VectorRegister4Float NZ = VectorLoad(Normals.Z.GetData() + k);
+
+		const VectorRegister4Float Dot = VectorMultiplyAdd(NX, TX, VectorMultiplyAdd(NY, TY, VectorMultiply(NZ, TZ)));
+		NX = VectorNegateMultiplyAdd(Dot, TX, NX);
+		NY = VectorNegateMultiplyAdd(Dot, TY, NY);
+		NZ = VectorNegateMultiplyAdd(Dot, TZ, NZ);
+
+		// Degenerate normals end up zero, as FVector::GetSafeNormal() does.
+		const VectorRegister4Float SizeSquared = VectorMultiplyAdd(NX, NX, VectorMultiplyAdd(NY, NY, VectorMultiply(NZ, NZ)));
+		const VectorRegister4Float InvSize = VectorSelect(VectorCompareGT(SizeSquared, Threshold), VectorReciprocalSqrtAccurate(SizeSquared), Zero);
+
+		VectorStore(VectorMultiply(NX, InvSize), Normals.X.GetData() + k);
+		VectorStore(VectorMultiply(NY, InvSize), Normals.Y.GetData() + k);
+		VectorStore(VectorMultiply(NZ, InvSize), Normals.Z.GetData() + k);
+	}
+
+	for (; k <= Last; ++k)
+	{
+		OrthonormalizeNormal(Tangents, Normals, k);
+	}
+}
+
+int32 FAedificRotationMinimizingFrames::Propagate(TConstArrayView<FVector> Positions, const FAedificVectorStreams& Tangents, FAedificVectorStreams& Normals, const int32 FirstFrame, const int32 ConvergenceFrame)
+{
+	const int32 NumFrames = Normals.Num();
+	check(Positions.Num() == NumFrames);
+
+	int32 LastChangedFrame = INDEX_NONE;
+
+	if (FirstFrame == 0 && NumFrames > 0)
+	{
+		const FVector InitialUp = FVector::UpVector; // Define an initial "up" direction.
+		const FVector Tangent = Tangents.Get(0);
+
+		// The first normal is calculated by making the InitialUp vector orthogonal to the first tangent.
+		Normals.Set(0, (InitialUp - Tangent * FVector::DotProduct(InitialUp, Tangent)).GetSafeNormal());
+		LastChangedFrame = 0;
+	}
+
+	const int32 FirstPropagated = FMath::Max(FirstFrame, 1);
+	if (FirstPropagated >= NumFrames)
+	{
+		return LastChangedFrame;
+	}
+
+	// Reflection planes don't depend on the normals, so they're all computed up front.
+	FAedificReflectionStreams Reflections;
+	Reflections.SetNumUninitialized(NumFrames - 1);
+	ComputeReflections(Positions, Tangents, Reflections, FirstPropagated - 1, NumFrames - 2);
+
+	FVector Normal = Normals.Get(FirstPropagated - 1);
+
+	for (int32 k = FirstPropagated; k < NumFrames; ++k)
+	{
+		const int32 i = k - 1;
+		const FVector V1 = Reflections.V1.Get(i);
+		const FVector V2 = Reflections.V2.Get(i);
+
+		Normal -= V1 * (Reflections.K1[i] * FVector::DotProduct(V1, Normal));
+		Normal -= V2 * (Reflections.K2[i] * FVector::DotProduct(V2, Normal));
+
+		if (ConvergenceFrame != INDEX_NONE && k > ConvergenceFrame && Normal.Equals(Normals.Get(k), KINDA_SMALL_NUMBER))
+		{
+			break;
+		}
+
+		Normals.Set(k, Normal);
+		LastChangedFrame = k;
+	}
+
+	// Reflections preserve lengths and angles, this only removes the floating point drift.
+	if (LastChangedFrame >= FirstPropagated)
+	{
+		OrthonormalizeNormals(Tangents, Normals, FirstPropagated, LastChangedFrame);
+	}
+
+	return LastChangedFrame;
+}
+
+void FAedificRotationMinimizingFrames::CloseLoop(const FAedificVectorStreams& Tangents, FAedificVectorStreams& Normals)
+{
+	const int32 NumFrames = Normals.Num();
+	if (NumFrames < 2)
+	{
+		return;
+	}
+
+	// Signed angle rolling the last normal onto the first one, around their shared tangent.
+	const FVector Tangent = Tangents.Get(0);
+	const FVector FirstNormal = Normals.Get(0);
+	const FVector LastNormal = Normals.Get(NumFrames - 1);
+
+	const float TwistAngle = FMath::Atan2(FVector::DotProduct(Tangent, FVector::CrossProduct(LastNormal, FirstNormal)), FVector::DotProduct(LastNormal, FirstNormal));
+	const float AngleStep = TwistAngle / (float)(NumFrames - 1);
+
+	// Each normal rolls by its share of the twist: N' = N * cos(a) + (T x N) * sin(a).
+	auto RollNormal = [&](const int32 k)
+	{
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, AngleStep * k);
+
+		const FVector Normal = Normals.Get(k);
+		Normals.Set(k, Normal * Cos + FVector::CrossProduct(Tangents.Get(k), Normal) * Sin);
+	};
+
+	const VectorRegister4Float Step = VectorSetFloat1(AngleStep);
+	const VectorRegister4Float Offsets = MakeVectorRegisterFloat(0.f, 1.f, 2.f, 3.f);
+
+	int32 k = 0;
+	for (; k + 4 <= NumFrames; k += 4)
+	{
+		const VectorRegister4Float Angles = VectorMultiply(Step, VectorAdd(VectorSetFloat1((float)k), Offsets));
+
+		VectorRegister4Float Sin, Cos;
+		VectorSinCos(&Sin, &Cos, &Angles);
+
+		const VectorRegister4Float TX = VectorLoad(Tangents.X.GetData() + k);
+		const VectorRegister4Float TY = VectorLoad(Tangents.Y.GetData() + k);
+		const VectorRegister4Float TZ = VectorLoad(Tangents.Z.GetData() + k);
+
+		const VectorRegister4Float NX = VectorLoad(Normals.X.GetData() + k);
+		const VectorRegister4Float NY = VectorLoad(Normals.Y.GetData() + k);
+		const VectorRegister4Float NZ = VectorLoad(Normals.Z.GetData() + k);
+
+		const VectorRegister4Float BX = VectorNegateMultiplyAdd(TZ, NY, VectorMultiply(TY, NZ));
+		const VectorRegister4Float BY = VectorNegateMultiplyAdd(TX, NZ, VectorMultiply(TZ, NX));
+		const VectorRegister4Float BZ = VectorNegateMultiplyAdd(TY, NX, VectorMultiply(TX, NY));
+
+		VectorStore(VectorMultiplyAdd(BX, Sin, VectorMultiply(NX, Cos)), Normals.X.GetData() + k);
+		VectorStore(VectorMultiplyAdd(BY, Sin, VectorMultiply(NY, Cos)), Normals.Y.GetData() + k);
+		VectorStore(VectorMultiplyAdd(BZ, Sin, VectorMultiply(NZ, Cos)), Normals.Z.GetData() + k);
+	}
+
+	for (; k < NumFrames; ++k)
+	{
+		RollNormal(k);
+	}
+
+	// Re-orthonormalize one last time.
+	OrthonormalizeNormals(Tangents, Normals, 0, NumFrames - 1);
+}
+
+void FAedificRotationMinimizingFrames::PropagateReference(TConstArrayView<FVector> Tangents, TArrayView<FVector> Normals, const bool bClosedLoop)
+{
+	const int32 NumFrames = Normals.Num();
+
+	Normals[0] = (FVector::UpVector - Tangents[0] * FVector::DotProduct(FVector::UpVector, Tangents[0])).GetSafeNormal();
+
+	for (int32 k = 1; k < NumFrames; ++k)
+	{
+		const FQuat DeltaRotation = FQuat::FindBetweenNormals(Tangents[k - 1], Tangents[k]);
+		const FVector Normal = DeltaRotation.RotateVector(Normals[k - 1]);
+		Normals[k] = (Normal - Tangents[k] * FVector::DotProduct(Normal, Tangents[k])).GetSafeNormal();
+	}
+
+	// Each normal rolls around its own tangent, a single rotation around the first tangent is only right near the seam.
+	if (bClosedLoop && NumFrames > 1)
+	{
+		const double TwistAngle = FMath::Atan2(FVector::DotProduct(Tangents[0], FVector::CrossProduct(Normals[NumFrames - 1], Normals[0])), FVector::DotProduct(Normals[NumFrames - 1], Normals[0]));
+
+		for (int32 j = 0; j < NumFrames; ++j)
+		{
+			const FVector Normal = FQuat(Tangents[j], TwistAngle * j / (NumFrames - 1)).RotateVector(Normals[j]);
+			Normals[j] = (Normal - Tangents[j] * FVector::DotProduct(Normal, Tangents[j])).GetSafeNormal();
+		}
+	}
+}
+
+static void BenchmarkFrames(const TArray<FString>& Args)
+{
+	static const int32 FrameCounts[] = { 1000, 10000, 100000 };
+
+	for (const int32 NumFrames : FrameCounts)
+	{
+		for (const bool bClosedLoop : { false, true })
+		{
+			// A torus knot, closed on itself and twisting in every direction.
+			TArray<FVector> Positions; Positions.SetNumUninitialized(NumFrames);
+			TArray<FVector> Tangents; Tangents.SetNumUninitialized(NumFrames);
+
+			for (int32 k = 0; k < NumFrames; ++k)
+			{
+				const float T = UE_TWO_PI * (float)k / (float)(NumFrames - 1);
+				const float Radius = 1000.f + 300.f * FMath::Cos(3.f * T);
+
+				Positions[k] = FVector(Radius * FMath::Cos(2.f * T), Radius * FMath::Sin(2.f * T), 300.f * FMath::Sin(3.f * T));
+			}
+
+			for (int32 k = 0; k < NumFrames; ++k)
+			{
+				const int32 Prev = (k > 0) ? k - 1 : (bClosedLoop ? NumFrames - 2 : 0);
+				const int32 Next = (k < NumFrames - 1) ? k + 1 : (bClosedLoop ? 1 : NumFrames - 1);
+				Tangents[k] = (Positions[Next] - Positions[Prev]).GetSafeNormal();
+			}
+
+			TArray<FVector> ReferenceNormals; ReferenceNormals.SetNumUninitialized(NumFrames);
+
+			const double ReferenceStart = FPlatformTime::Seconds();
+			FAedificRotationMinimizingFrames::PropagateReference(Tangents, ReferenceNormals, bClosedLoop);
+			const double ReferenceTime = FPlatformTime::Seconds() - ReferenceStart;
+
+			FAedificVectorStreams TangentStreams; TangentStreams.SetNumUninitialized(NumFrames);
+			FAedificVectorStreams NormalStreams; NormalStreams.SetNumUninitialized(NumFrames);
+
+			for (int32 k = 0; k < NumFrames; ++k)
+			{
+				TangentStreams.Set(k, Tangents[k]);
+			}
+
+			const double KernelStart = FPlatformTime::Seconds();
+			FAedificRotationMinimizingFrames::Propagate(Positions, TangentStreams, NormalStreams, 0);
+			if (bClosedLoop)
+			{
+				FAedificRotationMinimizingFrames::CloseLoop(TangentStreams, NormalStreams);
+			}
+			const double KernelTime = FPlatformTime::Seconds() - KernelStart;
+
+			float MaxDeviation = 0.f;
+			for (int32 k = 0; k < NumFrames; ++k)
+			{
+				const float Cos = FMath::Clamp((float)FVector::DotProduct(ReferenceNormals[k], NormalStreams.Get(k)), -1.f, 1.f);
+				MaxDeviation = FMath::Max(MaxDeviation, FMath::RadiansToDegrees(FMath::Acos(Cos)));
+			}
+
+			UE_LOG(LogAedific, Display, TEXT("%d %s frames: reference %.3f ms, kernel %.3f ms, max normal deviation %.4f degrees."),
+				NumFrames, bClosedLoop ? TEXT("closed") : TEXT("open"), ReferenceTime * 1000.0, KernelTime * 1000.0, MaxDeviation);
+		}
+	}
+}
+
+static FAutoConsoleCommand BenchmarkFramesCommand(
+	TEXT("Aedific.BenchmarkFrames"),
+	TEXT("Times the rotation-minimizing frame kernel against the scalar Parallel Transport reference at 1k, 10k and 100k frames, the accuracy is checked by the Aedific.Frames automation tests."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkFrames));
@@ -0,0 +1,393 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificSegmentBuilder.h"
+#include "Aedific.h"
+#include "AedificSplineMath.h"
+
+#include <Async/ParallelFor.h>
+#include <Misc/ScopeExit.h>
+#include <ProfilingDebugging/CpuProfilerTrace.h>
+
+DECLARE_CYCLE_STAT(TEXT("Build Segments"), STAT_AedificBuildSegments, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Build Segments (Parallel Transport)"), STAT_AedificBuildSegmentsParallelTransport, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Compute Segment Boundaries"), STAT_AedificComputeBoundaries, STATGROUP_Aedific);
+
+bool FAedificSegmentBuilder::Build(FAedificSegmentBuild& Build)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT { Build.BuildTime = FPlatformTime::Seconds() - StartTime; };
+
+	ComputeBoundaries(Build);
+
+	if (Build.bCancelled)
+	{
+		return false;
+	}
+
+	if (Build.State.bParallelTransport)
+	{
+		BuildSegmentsParallelTransport(Build);
+	}
+	else
+	{
+		BuildSegments(Build);
+	}
+
+	return !Build.bCancelled;
+}
+
+void FAedificSegmentBuilder::ComputeBoundaries(FAedificSegmentBuild& Build)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::ComputeBoundaries);
+	SCOPE_CYCLE_COUNTER(STAT_AedificComputeBoundaries);
+
+	const float MeshLength = Build.MeshLength;
+	const float SplineLength = Build.SplineLength;
+	const FAedificSegmentation& Segmentation = Build.State.Segmentation;
+
+	TArray<float>& Boundaries = Build.Boundaries;
+	Boundaries.Reset();
+
+	if (!Segmentation.bAdaptive)
+	{
+		// Parallel Transport spreads the frames evenly, the others tile the mesh and cut the last one short.
+		const float Spacing = Build.State.bParallelTransport ? SplineLength / (float)Build.LoopSize : MeshLength;
+
+		Boundaries.SetNumUninitialized(Build.LoopSize + 1);
+		for (int32 i = 0; i <= Build.LoopSize; ++i)
+		{
+			Boundaries[i] = FMath::Min(i * Spacing, SplineLength);
+		}
+
+		return;
+	}
+
+	// Squashing the mesh any further would look broken, whatever the curvature.
+	const float MinLength = MeshLength * 0.25f;
+	const float MaxLength = MeshLength * FMath::Max(Segmentation.MaxStretch, 1.f);
+
+	// Parallel Transport frames never twist, the spline's rolls are ignored.
+	const bool bCheckTwist = !Build.State.bParallelTransport;
+
+	const FAedificSplineSampler& Sampler = Build.Sampler;
+
+	auto IsWithinTolerance = [&](const FAedificSplineSample& Start, const float EndDistance)
+	{
+		const FAedificSplineSample End = Sampler.SampleAtDistance(EndDistance);
+		if (bCheckTwist && FAedificSplineMath::GetTwistDegrees(Start.GetDirection(), Start.GetUpVector(), End.GetDirection(), End.GetUpVector()) > Segmentation.MaxTwistDegrees)
+		{
+			return false;
+		}
+
+		// Probe about every quarter of a mesh, so S-bends within long segments aren't missed.
+		const float Length = EndDistance - Start.Distance;
+		const int32 NumProbes = FMath::Clamp(FMath::CeilToInt(4.f * Length / MeshLength), 3, 16);
+
+		for (int32 Probe = 1; Probe <= NumProbes; ++Probe)
+		{
+			const FVector Location = Sampler.SampleAtDistance(Start.Distance + Length * Probe / (NumProbes + 1)).Location;
+			if (FMath::PointDistToSegment(Location, Start.Location, End.Location) > Segmentation.MaxChordDeviation)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	};
+
+	Boundaries.Reserve(FMath::CeilToInt(SplineLength / MeshLength) + 1);
+	Boundaries.Add(0.f);
+
+	float StartDistance = 0.f;
+	while (SplineLength - StartDistance > KINDA_SMALL_NUMBER && !Build.bCancelled)
+	{
+		const FAedificSplineSample Start = Sampler.SampleAtDistance(StartDistance);
+
+		float Low = FMath::Min(MinLength, SplineLength - StartDistance);
+		float High = FMath::Min(MaxLength, SplineLength - StartDistance);
+
+		// Straight runs take the longest segment right away, curves bisect the longest one within tolerance.
+		if (IsWithinTolerance(Start, StartDistance + High))
+		{
+			Low = High;
+		}
+		else
+		{
+			for (int32 Iteration = 0; Iteration < 6 && High - Low > MinLength * 0.1f; ++Iteration)
+			{
+				const float Middle = (Low + High) * 0.5f;
+				if (IsWithinTolerance(Start, StartDistance + Middle))
+				{
+					Low = Middle;
+				}
+				else
+				{
+					High = Middle;
+				}
+			}
+		}
+
+		StartDistance = FMath::Min(StartDistance + Low, SplineLength);
+		Boundaries.Add(StartDistance);
+	}
+
+	Build.LoopSize = Boundaries.Num() - 1;
+}
+
+void FAedificSegmentBuilder::BuildSegments(FAedificSegmentBuild& Build)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::BuildSegments);
+	SCOPE_CYCLE_COUNTER(STAT_AedificBuildSegments);
+
+	const int32 LoopSize = Build.LoopSize;
+	const FAedificDirtyRange& DirtyRange = Build.DirtyRange;
+	const TArray<float>& Boundaries = Build.Boundaries;
+
+	// Segments before the edit, or past it when the spline length didn't change, are identical to the last build.
+	// Adaptive boundaries past the edit may have shifted, only the ones before it are known to be the same.
+	auto IsSegmentKept = [&](const int32 i, const float CurrentDistance, const float NextDistance)
+	{
+		if (DirtyRange.bFullRebuild || !Build.PreviousSegments.IsValidIndex(i))
+		{
+			return false;
+		}
+
+		const bool bBeforeEdit = NextDistance < DirtyRange.StartDistance;
+		const bool bAfterEdit = CurrentDistance > DirtyRange.EndDistance && FMath::IsNearlyZero(DirtyRange.LengthOffset) && !Build.State.Segmentation.bAdaptive;
+		return bBeforeEdit || bAfterEdit;
+	};
+
+	// Start, middle and end distances of every regenerated segment, in ascending order so they're sampled in a single sweep.
+	TArray<float> SampleDistances;
+	SampleDistances.Reserve(LoopSize * 3);
+
+	// Index of each segment's first sample, or INDEX_NONE for the segments kept from the last build.
+	TArray<int32> SampleOffsets;
+	SampleOffsets.SetNumUninitialized(LoopSize);
+
+	for (int32 i = 0; i < LoopSize; i++)
+	{
+		const float CurrentDistance = Boundaries[i];
+		const float NextDistance = Boundaries[i + 1];
+
+		if (IsSegmentKept(i, CurrentDistance, NextDistance))
+		{
+			SampleOffsets[i] = INDEX_NONE;
+			continue;
+		}
+
+		SampleOffsets[i] = SampleDistances.Num();
+		SampleDistances.Add(CurrentDistance);
+		SampleDistances.Add((CurrentDistance + NextDistance) / 2.f);
+		SampleDistances.Add(NextDistance);
+	}
+
+	TArray<FAedificSplineSample> Samples;
+	Samples.SetNum(SampleDistances.Num());
+	Build.Sampler.SampleAtDistances(SampleDistances, Samples);
+
+	if (Build.bCancelled)
+	{
+		return;
+	}
+
+	Build.Segments.SetNum(LoopSize);
+
+	ParallelFor(LoopSize, [&](const int32 i)
+	{
+		if (Build.bCancelled)
+		{
+			return;
+		}
+
+		if (SampleOffsets[i] == INDEX_NONE)
+		{
+			Build.Segments[i] = Build.PreviousSegments[i];
+			return;
+		}
+
+		const FString SegmentName = FString::Printf(TEXT("SplineMesh%d"), i);
+
+		const float CurrentDistance = Boundaries[i];
+		const float NextDistance = Boundaries[i + 1];
+		const float CurrentLenght = NextDistance - CurrentDistance;
+
+		const FAedificSplineSample& StartSample = Samples[SampleOffsets[i]];
+		const FAedificSplineSample& MidPointSample = Samples[SampleOffsets[i] + 1];
+		const FAedificSplineSample& EndSample = Samples[SampleOffsets[i] + 2];
+
+		const FVector StartLocation = StartSample.Location;
+		const FVector EndLocation = EndSample.Location;
+
+		const FVector UpVector = MidPointSample.GetUpVector();
+
+		const FVector StartTangent = StartSample.GetDirection() * FMath::Min(StartSample.Tangent.Size(), CurrentLenght);
+		const FVector EndTangent = EndSample.GetDirection() * FMath::Min(EndSample.Tangent.Size(), CurrentLenght);
+
+		const float StartRollDegrees = FAedificSplineMath::GetRelativeRoll(MidPointSample.Rotation, StartSample.GetDirection(), StartSample.GetRightVector(), StartSample.GetUpVector());
+		const float EndRollDegrees = FAedificSplineMath::GetRelativeRoll(MidPointSample.Rotation, EndSample.GetDirection(), EndSample.GetRightVector(), EndSample.GetUpVector());
+
+		// @TODO: Implement proper scaling.
+		const FVector2D StartScale = FVector2D(StartSample.Scale.Y, StartSample.Scale.Z);
+		const FVector2D EndScale = FVector2D(EndSample.Scale.Y, EndSample.Scale.Z);
+
+		FAedificMeshSegment Segment;
+		Segment.SegmentName			= SegmentName;
+		Segment.StartLocation		= StartLocation;
+		Segment.EndLocation			= EndLocation;
+		Segment.StartTangent		= StartTangent;
+		Segment.EndTangent			= EndTangent;
+		Segment.UpVector			= UpVector;
+		Segment.StartRollDegrees	= StartRollDegrees;
+		Segment.EndRollDegrees		= EndRollDegrees;
+		Segment.StartScale			= StartScale;
+		Segment.EndScale			= EndScale;
+
+		Build.Segments[i] = MoveTemp(Segment);
+	});
+}
+
+void FAedificSegmentBuilder::BuildSegmentsParallelTransport(FAedificSegmentBuild& Build)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::BuildSegmentsParallelTransport);
+	SCOPE_CYCLE_COUNTER(STAT_AedificBuildSegmentsParallelTransport);
+
+	const float SplineLength = Build.SplineLength;
+	const int32 LoopSize = Build.LoopSize;
+	const FAedificDirtyRange& DirtyRange = Build.DirtyRange;
+
+	// Determine the number of points (frames) to generate. For N segments, we need N+1 points.
+	const int32 NumFrames = LoopSize + 1;
+
+	// Distance between the frames when they are evenly spaced.
+	const float Spacing = SplineLength / (float)LoopSize;
+
+	const bool bClosedLoop = Build.Sampler.IsClosedLoop();
+
+	// Frames can only be partially rebuilt on an open spline of unchanged length, as both the spacing
+	// and the closed loop correction depend on the whole spline. Adaptive frames aren't evenly spaced.
+	const bool bPartial = !DirtyRange.bFullRebuild && !bClosedLoop && FMath::IsNearlyZero(DirtyRange.LengthOffset) && !Build.State.Segmentation.bAdaptive
+		&& Build.State.FrameNormals.Num() == NumFrames && Build.PreviousSegments.Num() == LoopSize;
+
+	// Range of frames whose position and tangent must be sampled again.
+	int32 FirstDirtyFrame = 0;
+	int32 LastDirtyFrame = NumFrames - 1;
+
+	if (bPartial)
+	{
+		if (DirtyRange.IsEmpty())
+		{
+			FirstDirtyFrame = NumFrames;
+			LastDirtyFrame = INDEX_NONE;
+		}
+		else
+		{
+			FirstDirtyFrame = FMath::Clamp(FMath::FloorToInt(DirtyRange.StartDistance / Spacing), 0, NumFrames - 1);
+			LastDirtyFrame = FMath::Clamp(FMath::CeilToInt(DirtyRange.EndDistance / Spacing), 0, NumFrames - 1);
+		}
+	}
+
+	// Sample positions and tangents at evenly spaced distances along the spline.
+	// These will form the "spine" for our generated meshes.
+	TArray<FVector>& Positions = Build.State.FramePositions;
+	FAedificVectorStreams& Tangents = Build.State.FrameTangents;
+	FAedificVectorStreams& Normals = Build.State.FrameNormals;
+
+	if (!bPartial)
+	{
+		Positions.SetNumUninitialized(NumFrames);
+		Tangents.SetNumUninitialized(NumFrames);
+		Normals.SetNumUninitialized(NumFrames);
+	}
+
+	if (FirstDirtyFrame <= LastDirtyFrame)
+	{
+		// Frames sit on the segment boundaries.
+		TArray<float> SampleDistances(&Build.Boundaries[FirstDirtyFrame], LastDirtyFrame - FirstDirtyFrame + 1);
+
+		TArray<FAedificSplineSample> Samples;
+		Samples.SetNum(SampleDistances.Num());
+		Build.Sampler.SampleAtDistances(SampleDistances, Samples);
+
+		for (int32 k = FirstDirtyFrame; k <= LastDirtyFrame; ++k)
+		{
+			Positions[k] = Samples[k - FirstDirtyFrame].Location;
+			Tangents.Set(k, Samples[k - FirstDirtyFrame].GetDirection());
+		}
+	}
+
+	// Build normals using rotation-minimizing frames to create smooth, twist-free orientation frames.
+	// Normals are propagated downstream from the first dirty frame; past the dirty frames the tangents are the
+	// same as the last build, so propagation stops as soon as a normal converges with the previous one.
+	int32 LastChangedFrame = LastDirtyFrame;
+	if (FirstDirtyFrame < NumFrames)
+	{
+		LastChangedFrame = FMath::Max(LastChangedFrame, FAedificRotationMinimizingFrames::Propagate(Positions, Tangents, Normals, FirstDirtyFrame, bPartial ? LastDirtyFrame : INDEX_NONE));
+	}
+
+	// If the spline is a closed loop, distribute the accumulated rotational error.
+	if (bClosedLoop)
+	{
+		FAedificRotationMinimizingFrames::CloseLoop(Tangents, Normals);
+	}
+
+	if (Build.bCancelled)
+	{
+		return;
+	}
+
+	// Generate the segments using the frames.
+	// Each segment 'i' uses frame 'i' for its start and frame 'i+1' for its end.
+	Build.Segments.SetNum(LoopSize);
+
+	ParallelFor(LoopSize, [&](const int32 i)
+	{
+		if (Build.bCancelled)
+		{
+			return;
+		}
+
+		const int32 StartIndex = i;
+		const int32 EndIndex = i + 1;
+
+		// Segments whose frames are all untouched are identical to the last build.
+		if (bPartial && (EndIndex < FirstDirtyFrame || StartIndex > LastChangedFrame))
+		{
+			Build.Segments[i] = Build.PreviousSegments[i];
+			return;
+		}
+
+		const FVector StartTangentVec = Tangents.Get(StartIndex);
+		const FVector EndTangentVec = Tangents.Get(EndIndex);
+		const FVector StartNormalVec = Normals.Get(StartIndex);
+		const FVector EndNormalVec = Normals.Get(EndIndex);
+		const FVector& StartPosition = Positions[StartIndex];
+		const FVector& EndPosition = Positions[EndIndex];
+
+		// The magnitude of the tangent for a spline mesh controls its curvature.
+		// A good default is the distance between the points.
+		const float TangentMagnitude = (EndPosition - StartPosition).Size();
+
+		// @TODO: Combine with user inputed Spline rotation.
+		// Calculate the reference up-vector, and the roll needed at the start and end of the segment.
+		FVector ReferenceUp;
+		float StartRoll, EndRoll;
+		FAedificSplineMath::ComputeFrameSegmentRolls(StartTangentVec, StartNormalVec, EndTangentVec, EndNormalVec, ReferenceUp, StartRoll, EndRoll);
+
+		FAedificMeshSegment Segment;
+		Segment.SegmentName			= FString::Printf(TEXT("SplineMesh%d"), i);
+		Segment.UpVector			= ReferenceUp; // For SetSplineUpDir()
+		Segment.StartLocation		= StartPosition;
+		Segment.StartTangent		= StartTangentVec * TangentMagnitude;
+		Segment.EndLocation			= EndPosition;
+		Segment.EndTangent			= EndTangentVec * TangentMagnitude;
+		Segment.StartRollDegrees	= StartRoll;
+		Segment.EndRollDegrees		= EndRoll;
+
+		// @TODO: Implement proper scaling.
+		Segment.StartScale	= FVector2D::UnitVector;
+		Segment.EndScale	= FVector2D::UnitVector;
+
+		Build.Segments[i] = MoveTemp(Segment);
+	});
+}
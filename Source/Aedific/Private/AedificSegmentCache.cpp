@@ -0,0 +1,113 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificSegmentCache.h"
+
+#include <Math/Float16.h>
+#include <Serialization/MemoryReader.h>
+#include <Serialization/MemoryWriter.h>
+
+/** Bumped whenever the layout below changes, older caches are then ignored and the segments regenerated. */
+static constexpr uint8 AedificSegmentCacheVersion = 1;
+
+/** Serialized size of a single segment. */
+static constexpr int32 AedificSegmentCacheStride = 4 * sizeof(FVector3f) + 3 * sizeof(int16) + 2 * sizeof(float) + 4 * sizeof(FFloat16);
+
+static void SerializeLocation(FArchive& Ar, FVector& Location)
+{
+	FVector3f Value(Location);
+	Ar << Value;
+	Location = FVector(Value);
+}
+
+static void SerializeDirection(FArchive& Ar, FVector& Direction)
+{
+	int16 X = (int16)FMath::RoundToInt(FMath::Clamp(Direction.X, -1.0, 1.0) * MAX_int16);
+	int16 Y = (int16)FMath::RoundToInt(FMath::Clamp(Direction.Y, -1.0, 1.0) * MAX_int16);
+	int16 Z = (int16)FMath::RoundToInt(FMath::Clamp(Direction.Z, -1.0, 1.0) * MAX_int16);
+	Ar << X << Y << Z;
+	Direction = FVector(X, Y, Z).GetSafeNormal();
+}
+
+static void SerializeScale(FArchive& Ar, FVector2D& Scale)
+{
+	FFloat16 X((float)Scale.X);
+	FFloat16 Y((float)Scale.Y);
+	Ar << X << Y;
+	Scale = FVector2D(X.GetFloat(), Y.GetFloat());
+}
+
+static void SerializeSegment(FArchive& Ar, FAedificMeshSegment& Segment)
+{
+	SerializeLocation(Ar, Segment.StartLocation);
+	SerializeLocation(Ar, Segment.EndLocation);
+	SerializeLocation(Ar, Segment.StartTangent);
+	SerializeLocation(Ar, Segment.EndTangent);
+	SerializeDirection(Ar, Segment.UpVector);
+	Ar << Segment.StartRollDegrees;
+	Ar << Segment.EndRollDegrees;
+	SerializeScale(Ar, Segment.StartScale);
+	SerializeScale(Ar, Segment.EndScale);
+}
+
+void FAedificSegmentCache::Write(TArray<uint8>& Data, const FAedificSegmentCacheHeader& Header, const TArray<FAedificMeshSegment>& Segments)
+{
+	Data.Reset();
+
+	FMemoryWriter Writer(Data);
+
+	uint8 Version = AedificSegmentCacheVersion;
+	FAedificSegmentCacheHeader WrittenHeader = Header;
+	int32 NumSegments = Segments.Num();
+
+	Writer << Version;
+	Writer << WrittenHeader.InputHash;
+	Writer << WrittenHeader.MeshLength;
+	Writer << WrittenHeader.SplineLength;
+	Writer << NumSegments;
+
+	Data.Reserve(Data.Num() + NumSegments * AedificSegmentCacheStride);
+
+	for (const FAedificMeshSegment& Segment : Segments)
+	{
+		FAedificMeshSegment WrittenSegment = Segment;
+		SerializeSegment(Writer, WrittenSegment);
+	}
+}
+
+bool FAedificSegmentCache::Read(const TArray<uint8>& Data, FAedificSegmentCacheHeader& OutHeader, TArray<FAedificMeshSegment>& OutSegments)
+{
+	if (Data.Num() == 0)
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+
+	uint8 Version = 0;
+	int32 NumSegments = 0;
+
+	Reader << Version;
+	if (Version != AedificSegmentCacheVersion)
+	{
+		return false;
+	}
+
+	Reader << OutHeader.InputHash;
+	Reader << OutHeader.MeshLength;
+	Reader << OutHeader.SplineLength;
+	Reader << NumSegments;
+
+	if (Reader.IsError() || NumSegments < 0 || Reader.TotalSize() - Reader.Tell() != (int64)NumSegments * AedificSegmentCacheStride)
+	{
+		return false;
+	}
+
+	OutSegments.SetNum(NumSegments);
+
+	for (FAedificMeshSegment& Segment : OutSegments)
+	{
+		SerializeSegment(Reader, Segment);
+	}
+
+	return !Reader.IsError();
+}
@@ -0,0 +1,426 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificSegmentIndex.h"
+#include "Aedific.h"
+
+#include <ProfilingDebugging/CpuProfilerTrace.h>
+
+DECLARE_CYCLE_STAT(TEXT("Build Segment Index"), STAT_AedificBuildSegmentIndex, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Refit Segment Index"), STAT_AedificRefitSegmentIndex, STATGROUP_Aedific);
+
+/** Maximum amount of segments in a leaf of the hierarchy. */
+static constexpr int32 SegmentsPerLeaf = 4;
+
+FAedificSegmentIndex::FAedificSegmentIndex()
+{
+	Transform = FTransform::Identity;
+	CrossSectionRadius = 0.f;
+	NumSegments = 0;
+}
+
+void FAedificSegmentIndex::Build(TConstArrayView<FAedificMeshSegment> Segments, const FTransform& InTransform, const float InCrossSectionRadius)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::BuildSegmentIndex);
+	SCOPE_CYCLE_COUNTER(STAT_AedificBuildSegmentIndex);
+
+	Transform = InTransform;
+	CrossSectionRadius = FMath::Max(InCrossSectionRadius, 0.f);
+	NumSegments = Segments.Num();
+
+	Points.SetNumUninitialized(NumSegments * (PiecesPerSegment + 1));
+	PointOffsets.SetNumUninitialized(NumSegments * (PiecesPerSegment + 1));
+	SegmentRadii.SetNumUninitialized(NumSegments);
+	SegmentBounds.SetNumUninitialized(NumSegments);
+
+	for (int32 i = 0; i < NumSegments; ++i)
+	{
+		UpdateSegment(i, Segments[i]);
+	}
+
+	UpdateSplineDistances();
+
+	Nodes.Reset(FMath::Max(2 * FMath::DivideAndRoundUp(NumSegments, SegmentsPerLeaf) - 1, 0));
+
+	if (NumSegments > 0)
+	{
+		BuildNode(0, NumSegments);
+	}
+}
+
+bool FAedificSegmentIndex::Refit(TConstArrayView<FAedificMeshSegment> Segments, const int32 FirstSegment, const int32 LastSegment)
+{
+	if (Segments.Num() != NumSegments)
+	{
+		return false;
+	}
+
+	const int32 First = FMath::Max(FirstSegment, 0);
+	const int32 Last = FMath::Min(LastSegment, NumSegments - 1);
+	if (First > Last)
+	{
+		return true;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::RefitSegmentIndex);
+	SCOPE_CYCLE_COUNTER(STAT_AedificRefitSegmentIndex);
+
+	for (int32 i = First; i <= Last; ++i)
+	{
+		UpdateSegment(i, Segments[i]);
+	}
+
+	// Lengths of the updated segments shift the distances of all the following ones.
+	UpdateSplineDistances();
+	RefitNode(0, First, Last);
+
+	return true;
+}
+
+void FAedificSegmentIndex::UpdateSegment(const int32 Index, const FAedificMeshSegment& Segment)
+{
+	const FVector& P0 = Segment.StartLocation;
+	const FVector& P1 = Segment.EndLocation;
+	const FVector& T0 = Segment.StartTangent;
+	const FVector& T1 = Segment.EndTangent;
+
+	// Spline meshes deform along a cubic Hermite curve, sampled at regular parameters.
+	FVector PreviousLocal = P0;
+	float Offset = 0.f;
+
+	for (int32 k = 0; k <= PiecesPerSegment; ++k)
+	{
+		const float T = (float)k / PiecesPerSegment;
+		const float T2 = T * T;
+		const float T3 = T2 * T;
+
+		const FVector Local = (2.f * T3 - 3.f * T2 + 1.f) * P0 + (T3 - 2.f * T2 + T) * T0 + (-2.f * T3 + 3.f * T2) * P1 + (T3 - T2) * T1;
+
+		// Distances along the spline are measured in the Actor's space, like the spline's own.
+		Offset += (float)FVector::Dist(PreviousLocal, Local);
+		PreviousLocal = Local;
+
+		const int32 PointIndex = Index * (PiecesPerSegment + 1) + k;
+		Points[PointIndex] = Transform.TransformPosition(Local);
+		PointOffsets[PointIndex] = Offset;
+	}
+
+	const float SegmentScale = FMath::Max(Segment.StartScale.GetAbsMax(), Segment.EndScale.GetAbsMax());
+	const float Radius = CrossSectionRadius * SegmentScale * (float)Transform.GetMaximumAxisScale();
+	SegmentRadii[Index] = Radius;
+
+	// The curve lies within the hull of its Bezier control points.
+	FBox Bounds(ForceInit);
+	Bounds += Transform.TransformPosition(P0);
+	Bounds += Transform.TransformPosition(P0 + T0 / 3.f);
+	Bounds += Transform.TransformPosition(P1 - T1 / 3.f);
+	Bounds += Transform.TransformPosition(P1);
+
+	SegmentBounds[Index] = Bounds.ExpandBy(Radius);
+}
+
+void FAedificSegmentIndex::UpdateSplineDistances()
+{
+	SegmentStartDistances.SetNumUninitialized(NumSegments + 1);
+	SegmentStartDistances[0] = 0.f;
+
+	for (int32 i = 0; i < NumSegments; ++i)
+	{
+		SegmentStartDistances[i + 1] = SegmentStartDistances[i] + PointOffsets[i * (PiecesPerSegment + 1) + PiecesPerSegment];
+	}
+}
+
+int32 FAedificSegmentIndex::BuildNode(const int32 FirstSegment, const int32 Count)
+{
+	const int32 NodeIndex = Nodes.AddUninitialized();
+	Nodes[NodeIndex].FirstSegment = FirstSegment;
+	Nodes[NodeIndex].NumSegments = Count;
+	Nodes[NodeIndex].RightChild = INDEX_NONE;
+
+	if (Count <= SegmentsPerLeaf)
+	{
+		FBox Bounds(ForceInit);
+		for (int32 i = FirstSegment; i < FirstSegment + Count; ++i)
+		{
+			Bounds += SegmentBounds[i];
+		}
+
+		Nodes[NodeIndex].Bounds = Bounds;
+		return NodeIndex;
+	}
+
+	// Consecutive segments are close to each other, splitting them in spline order keeps the nodes compact.
+	const int32 LeftCount = Count / 2;
+	BuildNode(FirstSegment, LeftCount);
+	const int32 RightChild = BuildNode(FirstSegment + LeftCount, Count - LeftCount);
+
+	Nodes[NodeIndex].RightChild = RightChild;
+	Nodes[NodeIndex].Bounds = Nodes[NodeIndex + 1].Bounds + Nodes[RightChild].Bounds;
+
+	return NodeIndex;
+}
+
+void FAedificSegmentIndex::RefitNode(const int32 NodeIndex, const int32 FirstSegment, const int32 LastSegment)
+{
+	FNode& Node = Nodes[NodeIndex];
+	if (LastSegment < Node.FirstSegment || FirstSegment >= Node.FirstSegment + Node.NumSegments)
+	{
+		return;
+	}
+
+	if (Node.RightChild == INDEX_NONE)
+	{
+		Node.Bounds.Init();
+		for (int32 i = Node.FirstSegment; i < Node.FirstSegment + Node.NumSegments; ++i)
+		{
+			Node.Bounds += SegmentBounds[i];
+		}
+
+		return;
+	}
+
+	RefitNode(NodeIndex + 1, FirstSegment, LastSegment);
+	RefitNode(Node.RightChild, FirstSegment, LastSegment);
+
+	Node.Bounds = Nodes[NodeIndex + 1].Bounds + Nodes[Node.RightChild].Bounds;
+}
+
+bool FAedificSegmentIndex::FindClosestPoint(const FVector& Location, FAedificSegmentHit& OutHit, const double MaxDistance) const
+{
+	OutHit = FAedificSegmentHit();
+
+	if (Nodes.Num() == 0)
+	{
+		return false;
+	}
+
+	double BestDistanceSquared = (MaxDistance < MAX_dbl) ? FMath::Square(MaxDistance) : MAX_dbl;
+	int32 BestPoint = INDEX_NONE;
+	float BestAlpha = 0.f;
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Push(0);
+
+	while (Stack.Num() > 0)
+	{
+		const int32 NodeIndex = Stack.Pop();
+		const FNode& Node = Nodes[NodeIndex];
+
+		if (Node.Bounds.ComputeSquaredDistanceToPoint(Location) >= BestDistanceSquared)
+		{
+			continue;
+		}
+
+		if (Node.RightChild != INDEX_NONE)
+		{
+			// The nearest child is visited first, so the other one is more likely to be pruned.
+			const int32 LeftChild = NodeIndex + 1;
+			const bool bLeftFirst = Nodes[LeftChild].Bounds.ComputeSquaredDistanceToPoint(Location) <= Nodes[Node.RightChild].Bounds.ComputeSquaredDistanceToPoint(Location);
+
+			Stack.Push(bLeftFirst ? Node.RightChild : LeftChild);
+			Stack.Push(bLeftFirst ? LeftChild : Node.RightChild);
+			continue;
+		}
+
+		for (int32 i = Node.FirstSegment; i < Node.FirstSegment + Node.NumSegments; ++i)
+		{
+			if (SegmentBounds[i].ComputeSquaredDistanceToPoint(Location) >= BestDistanceSquared)
+			{
+				continue;
+			}
+
+			for (int32 k = 0; k < PiecesPerSegment; ++k)
+			{
+				const FVector& A = GetPoint(i, k);
+				const FVector& B = GetPoint(i, k + 1);
+				const FVector AB = B - A;
+				const double LengthSquared = AB.SizeSquared();
+				const float Alpha = (LengthSquared > UE_SMALL_NUMBER) ? (float)FMath::Clamp(((Location - A) | AB) / LengthSquared, 0.0, 1.0) : 0.f;
+
+				const double DistanceSquared = FVector::DistSquared(Location, A + AB * Alpha);
+				if (DistanceSquared < BestDistanceSquared)
+				{
+					BestDistanceSquared = DistanceSquared;
+					BestPoint = i * (PiecesPerSegment + 1) + k;
+					BestAlpha = Alpha;
+				}
+			}
+		}
+	}
+
+	if (BestPoint == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const int32 Segment = BestPoint / (PiecesPerSegment + 1);
+	OutHit.SegmentIndex = Segment;
+	OutHit.Location = FMath::Lerp(Points[BestPoint], Points[BestPoint + 1], (double)BestAlpha);
+	OutHit.SplineDistance = SegmentStartDistances[Segment] + FMath::Lerp(PointOffsets[BestPoint], PointOffsets[BestPoint + 1], BestAlpha);
+	OutHit.Distance = FMath::Sqrt(BestDistanceSquared);
+
+	return true;
+}
+
+bool FAedificSegmentIndex::Raycast(const FVector& Start, const FVector& End, FAedificSegmentHit& OutHit) const
+{
+	OutHit = FAedificSegmentHit();
+
+	const FVector Direction = End - Start;
+	const double Length = Direction.Size();
+
+	if (Nodes.Num() == 0 || Length <= UE_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	const FVector OneOverDirection = Direction.Reciprocal();
+
+	// Fraction of the line where the closest hit so far is.
+	double BestTime = 1.0;
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Push(0);
+
+	while (Stack.Num() > 0)
+	{
+		const int32 NodeIndex = Stack.Pop();
+		const FNode& Node = Nodes[NodeIndex];
+
+		if (!FMath::LineBoxIntersection(Node.Bounds, Start, Start + Direction * BestTime, Direction, OneOverDirection))
+		{
+			continue;
+		}
+
+		if (Node.RightChild != INDEX_NONE)
+		{
+			Stack.Push(Node.RightChild);
+			Stack.Push(NodeIndex + 1);
+			continue;
+		}
+
+		for (int32 i = Node.FirstSegment; i < Node.FirstSegment + Node.NumSegments; ++i)
+		{
+			const double Radius = SegmentRadii[i];
+
+			for (int32 k = 0; k < PiecesPerSegment; ++k)
+			{
+				const FVector& A = GetPoint(i, k);
+				const FVector& B = GetPoint(i, k + 1);
+
+				FVector OnLine, OnPiece;
+				FMath::SegmentDistToSegmentSafe(Start, End, A, B, OnLine, OnPiece);
+
+				const double DistanceSquared = FVector::DistSquared(OnLine, OnPiece);
+				if (DistanceSquared > FMath::Square(Radius))
+				{
+					continue;
+				}
+
+				// Steps back from the closest approach to where the line enters the piece's cross-section.
+				const double ClosestTime = ((OnLine - Start) | Direction) / FMath::Square(Length);
+				const double Time = FMath::Max(ClosestTime - FMath::Sqrt(FMath::Square(Radius) - DistanceSquared) / Length, 0.0);
+
+				if (Time < BestTime || OutHit.SegmentIndex == INDEX_NONE)
+				{
+					const FVector AB = B - A;
+					const double PieceLengthSquared = AB.SizeSquared();
+					const float Alpha = (PieceLengthSquared > UE_SMALL_NUMBER) ? (float)FMath::Clamp(((OnPiece - A) | AB) / PieceLengthSquared, 0.0, 1.0) : 0.f;
+					const int32 PointIndex = i * (PiecesPerSegment + 1) + k;
+
+					BestTime = Time;
+					OutHit.SegmentIndex = i;
+					OutHit.Location = Start + Direction * Time;
+					OutHit.SplineDistance = SegmentStartDistances[i] + FMath::Lerp(PointOffsets[PointIndex], PointOffsets[PointIndex + 1], Alpha);
+					OutHit.Distance = Length * Time;
+				}
+			}
+		}
+	}
+
+	return OutHit.IsValid();
+}
+
+void FAedificSegmentIndex::FindSegmentsInRadius(const FVector& Location, const double Radius, TArray<int32>& OutSegments) const
+{
+	if (Nodes.Num() == 0)
+	{
+		return;
+	}
+
+	const double RadiusSquared = FMath::Square(FMath::Max(Radius, 0.0));
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Push(0);
+
+	while (Stack.Num() > 0)
+	{
+		const int32 NodeIndex = Stack.Pop();
+		const FNode& Node = Nodes[NodeIndex];
+
+		if (Node.Bounds.ComputeSquaredDistanceToPoint(Location) > RadiusSquared)
+		{
+			continue;
+		}
+
+		// Left children are visited first, so the segments come out in spline order.
+		if (Node.RightChild != INDEX_NONE)
+		{
+			Stack.Push(Node.RightChild);
+			Stack.Push(NodeIndex + 1);
+			continue;
+		}
+
+		for (int32 i = Node.FirstSegment; i < Node.FirstSegment + Node.NumSegments; ++i)
+		{
+			if (SegmentBounds[i].ComputeSquaredDistanceToPoint(Location) > RadiusSquared)
+			{
+				continue;
+			}
+
+			const double MaxDistanceSquared = FMath::Square(Radius + SegmentRadii[i]);
+
+			for (int32 k = 0; k < PiecesPerSegment; ++k)
+			{
+				if (FVector::DistSquared(Location, FMath::ClosestPointOnSegment(Location, GetPoint(i, k), GetPoint(i, k + 1))) <= MaxDistanceSquared)
+				{
+					OutSegments.Add(i);
+					break;
+				}
+			}
+		}
+	}
+}
+
+void FAedificSegmentIndex::FindClosestPoints(TConstArrayView<FVector> Locations, TArrayView<FAedificSegmentHit> OutHits, const double MaxDistance) const
+{
+	check(OutHits.Num() == Locations.Num());
+
+	for (int32 i = 0; i < Locations.Num(); ++i)
+	{
+		FindClosestPoint(Locations[i], OutHits[i], MaxDistance);
+	}
+}
+
+void FAedificSegmentIndex::Raycasts(TConstArrayView<FVector> Starts, TConstArrayView<FVector> Ends, TArrayView<FAedificSegmentHit> OutHits) const
+{
+	check(Starts.Num() == Ends.Num() && OutHits.Num() == Starts.Num());
+
+	for (int32 i = 0; i < Starts.Num(); ++i)
+	{
+		Raycast(Starts[i], Ends[i], OutHits[i]);
+	}
+}
+
+void FAedificSegmentIndex::FindSegmentsInRadius(TConstArrayView<FVector> Locations, const double Radius, TArray<int32>& OutSegments, TArray<int32>& OutOffsets) const
+{
+	OutSegments.Reset();
+	OutOffsets.SetNumUninitialized(Locations.Num() + 1);
+
+	for (int32 i = 0; i < Locations.Num(); ++i)
+	{
+		OutOffsets[i] = OutSegments.Num();
+		FindSegmentsInRadius(Locations[i], Radius, OutSegments);
+	}
+
+	OutOffsets[Locations.Num()] = OutSegments.Num();
+}
@@ -1,10 +1,39 @@
 ﻿// Copyright (c) 2025 Ampere Games.
 
 #include "AedificSplineContinuum.h"
+#include "Aedific.h"
+#include "AedificContinuumChunk.h"
+#include "AedificDynamicMeshBuilder.h"
+#include "AedificInstancedSplineMeshComponent.h"
+#include "AedificMeshBaker.h"
+#include "AedificRebuildSubsystem.h"
+#include "AedificSegmentBuilder.h"
+#include "AedificSegmentCache.h"
+#include "AedificSegmentIndex.h"
+#include "AedificSplineFollowers.h"
+#include "AedificSplineMath.h"
 #include "AedificSplineTypes.h"
 
+#include <Async/Async.h>
+#include <HAL/IConsoleManager.h>
+#include <Misc/ScopeExit.h>
+#include <ProfilingDebugging/CpuProfilerTrace.h>
+#include <Tasks/Task.h>
+
+#include <Components/DynamicMeshComponent.h>
+#include <Components/HierarchicalInstancedStaticMeshComponent.h>
 #include <Components/SplineComponent.h>
 #include <Components/SplineMeshComponent.h>
+#include <Components/StaticMeshComponent.h>
+#include <Hash/xxhash.h>
+#include <Net/UnrealNetwork.h>
+#include <UObject/ObjectSaveContext.h>
+#include <UObject/UObjectArray.h>
+
+#if WITH_EDITOR
+#include <AssetRegistry/AssetRegistryModule.h>
+#include <UObject/Package.h>
+#endif // WITH_EDITOR
 
 #if WITH_EDITORONLY_DATA
 #include <Components/BillboardComponent.h>
@@ -14,12 +43,60 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AedificSplineContinuum)
 
+DECLARE_CYCLE_STAT(TEXT("Compute Spline"), STAT_AedificComputeSpline, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Compute Tangents"), STAT_AedificComputeTangents, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Compute Up Vectors"), STAT_AedificComputeUpVectors, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Start Rebuild"), STAT_AedificStartRebuild, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Materialize Segments"), STAT_AedificMaterializeSegments, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Create Segment"), STAT_AedificCreateSegment, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Finish Rebuild"), STAT_AedificFinishRebuild, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Bake Mesh"), STAT_AedificBakeMesh, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Scatter Mesh"), STAT_AedificScatterMesh, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Empty Mesh"), STAT_AedificEmptyMesh, STATGROUP_Aedific);
+DECLARE_CYCLE_STAT(TEXT("Update Virtualization"), STAT_AedificUpdateVirtualization, STATGROUP_Aedific);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rebuilds Requested"), STAT_AedificRebuildsRequested, STATGROUP_Aedific);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rebuilds Avoided"), STAT_AedificRebuildsAvoided, STATGROUP_Aedific);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rebuilds Executed"), STAT_AedificRebuildsExecuted, STATGROUP_Aedific);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Segments Applied"), STAT_AedificSegmentsApplied, STATGROUP_Aedific);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Components Created"), STAT_AedificComponentsCreated, STATGROUP_Aedific);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Components Destroyed"), STAT_AedificComponentsDestroyed, STATGROUP_Aedific);
+
+static TAutoConsoleVariable<bool> CVarAedificComponentClusters(
+	TEXT("Aedific.ComponentClusters"),
+	true,
+	TEXT("If continuums in game worlds group their generated components in a garbage collection cluster rooted at the Actor. Only in cooked builds."));
+
+static TAutoConsoleVariable<bool> CVarAedificAsyncRebuild(
+	TEXT("Aedific.AsyncRebuild"),
+	true,
+	TEXT("If the mesh segments are generated on worker threads, only applying them to the components on the game thread."));
+
+static TAutoConsoleVariable<float> CVarAedificPreviewCoarseness(
+	TEXT("Aedific.PreviewCoarseness"),
+	4.f,
+	TEXT("Length factor of the segments generated while a spline is interactively edited."));
+
+static TAutoConsoleVariable<int32> CVarAedificVirtualizationPoolSize(
+	TEXT("Aedific.VirtualizationPoolSize"),
+	32,
+	TEXT("Maximum amount of hidden components each continuum virtualizing its segments keeps in its pool, the others are destroyed."));
+
+static TAutoConsoleVariable<bool> CVarAedificSegmentCache(
+	TEXT("Aedific.SegmentCache"),
+	true,
+	TEXT("If the generated segments are saved with the continuums and restored on load, instead of being regenerated."));
+
 AAedificSplineContinuum::AAedificSplineContinuum()
 {
 	// Set default values for AActor interface members.
 	PrimaryActorTick.bStartWithTickEnabled = false;
 	PrimaryActorTick.bCanEverTick = false;
 
+	// Only runtime spline edits are replicated, the Actor stays dormant until the first one.
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	NetDormancy = DORM_Initial;
+
 	// Set default values for this class members.
 	StaticMesh = nullptr;
 	MaterialOverride = nullptr;
@@ -29,8 +106,44 @@ AAedificSplineContinuum::AAedificSplineContinuum()
 	bComputeUpVectors = true;
 	bAutoRebuildMesh = true;
 	bUseParallelTransport = false;
+	bAdaptiveSegmentation = false;
+	MaxChordDeviation = 5.f;
+	MaxSegmentTwist = 15.f;
+	MaxSegmentStretch = 4.f;
+	OutputMode = EAedificMeshOutput::SplineMeshes;
+	BakeChunkSize = 64;
+	DynamicChunkSize = 16;
+	ScatterSpacing = 0.f;
+	bVirtualizeSegments = false;
+	VirtualizationRadius = 50000.f;
+	VirtualizationHysteresis = 5000.f;
+#if WITH_EDITORONLY_DATA
+	bBakeStreamingChunks = false;
+	StreamingCellSize = 25600.f;
+#endif // WITH_EDITORONLY_DATA
 	bRebuildRequested = false;
+	bPreviewBuilt = false;
+	bBatchRebuild = false;
+	bBakeRequired = false;
+	bVirtualizationActive = false;
+	bVirtualizationRequested = false;
+#if WITH_EDITOR
+	bInteractiveEdit = false;
+	LastInteractiveEditTime = 0.0;
+#endif // WITH_EDITOR
+	InstancedMeshComponent = nullptr;
+	ScatteredMeshComponent = nullptr;
 	SplineMeshComponents.Empty();
+	PooledSplineMeshComponents.Empty();
+	PoolHits = 0;
+	PoolMisses = 0;
+	AvoidedRebuilds = 0;
+	NextMaterializedSegment = 0;
+	FirstUnindexedSegment = MAX_int32;
+	LastUnindexedSegment = INDEX_NONE;
+	DynamicMeshChunkSize = 0;
+	DynamicMeshGeneration = 0;
+	SplineEdits.Owner = this;
 
 	// Create scene component.
 	SceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("SceneComponent"));
@@ -81,10 +194,18 @@ AAedificSplineContinuum::AAedificSplineContinuum()
 #if WITH_EDITOR
 void AAedificSplineContinuum::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
+	// Must be known before the construction script reruns and requests a rebuild.
+	NotifyEdited(PropertyChangedEvent.ChangeType == EPropertyChangeType::Interactive);
+
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 
 	if (PropertyChangedEvent.GetPropertyName() == FName(TEXT("StaticMesh")))
 	{
+		// Segments built for the previous mesh can't be recycled as they are.
+		CancelPendingBuild();
+		BuildState.Reset();
+		MeshSegments.Reset();
+
 		if (StaticMesh)
 		{
 			RebuildMesh();
@@ -92,12 +213,28 @@ void AAedificSplineContinuum::PostEditChangeProperty(FPropertyChangedEvent& Prop
 		else
 		{
 			EmptyMesh();
+			TruncateStreamingChunks(0);
 		}
 	}
 	else if (PropertyChangedEvent.GetPropertyName() == FName(TEXT("MaterialOverride")))
 	{
 		UpdateMaterial();
 	}
+	else if (PropertyChangedEvent.GetPropertyName() == FName(TEXT("OutputMode")))
+	{
+		// The previous output stays visible until the rebuild replaces it.
+		if (!bAutoRebuildMesh)
+		{
+			EmptyUnusedOutputs();
+		}
+
+		bBakeRequired = true;
+	}
+	else if (PropertyChangedEvent.GetPropertyName() == FName(TEXT("BakeChunkSize")) || PropertyChangedEvent.GetMemberPropertyName() == FName(TEXT("BakedMeshDirectory"))
+		|| PropertyChangedEvent.GetPropertyName() == FName(TEXT("bBakeStreamingChunks")) || PropertyChangedEvent.GetPropertyName() == FName(TEXT("StreamingCellSize")))
+	{
+		bBakeRequired = true;
+	}
 }
 #endif // WITH_EDITOR
 
@@ -108,10 +245,133 @@ void AAedificSplineContinuum::BeginDestroy()
 	Super::BeginDestroy();
 }
 
-void AAedificSplineContinuum::OnConstruction(const FTransform& Transform)
+void AAedificSplineContinuum::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+
+	SegmentCache.Reset();
+
+	// Only segments matching the saved spline and settings are worth restoring.
+	if (!CVarAedificSegmentCache.GetValueOnAnyThread() || OutputMode == EAedificMeshOutput::Scattered || !SplineComponent || !StaticMesh
+		|| !IsRebuildComplete() || BuildState.InputHash == 0 || BuildState.InputHash != ComputeInputHash())
+	{
+		return;
+	}
+
+	FAedificSegmentCacheHeader Header;
+	Header.InputHash = BuildState.InputHash;
+	Header.MeshLength = BuildState.MeshLength;
+	Header.SplineLength = BuildState.SplineLength;
+
+	FAedificSegmentCache::Write(SegmentCache, Header, MeshSegments);
+}
+
+void AAedificSplineContinuum::PostLoad()
+{
+	Super::PostLoad();
+
+	FAedificSegmentCacheHeader Header;
+	if (CVarAedificSegmentCache.GetValueOnAnyThread() && SplineComponent && FAedificSegmentCache::Read(SegmentCache, Header, MeshSegments))
+	{
+		// The components saved with the Actor already display these segments, so the construction script's rebuild
+		// is skipped by the input hash. The spline is the one saved along with the cache, and referenced assets
+		// may not be fully loaded yet, so the hash itself is only verified by that rebuild.
+		BuildState.Reset();
+		BuildState.InputHash = Header.InputHash;
+		BuildState.MeshLength = Header.MeshLength;
+		BuildState.SplineLength = Header.SplineLength;
+		BuildState.bClosedLoop = SplineComponent->IsClosedLoop();
+		BuildState.bParallelTransport = bUseParallelTransport;
+
+		const int32 SplinePointsNum = SplineComponent->GetNumberOfSplinePoints();
+		BuildState.SplinePoints.Reset(SplinePointsNum);
+		for (int32 i = 0; i < SplinePointsNum; ++i)
+		{
+			BuildState.SplinePoints.Add(SplineComponent->GetSplinePointAt(i, ESplineCoordinateSpace::Local));
+		}
+
+		UE_LOG(LogAedific, Verbose, TEXT("%s: Restored %d segments from the segment cache."), *GetName(), MeshSegments.Num());
+	}
+	else
+	{
+		MeshSegments.Reset();
+	}
+
+	// Only needed until the next save.
+	SegmentCache.Empty();
+}
+
+void AAedificSplineContinuum::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AAedificSplineContinuum, SplineEdits);
+}
+
+bool AAedificSplineContinuum::CanBeClusterRoot() const
+{
+	// Like level clusters, only created in cooked builds. Called by the loader, on any thread.
+	// Dynamic meshes are rebuilt asynchronously after every runtime edit, and virtualized segments acquire and destroy
+	// components as the players move, components can be created at any time.
+	return OutputMode != EAedificMeshOutput::Dynamic && !bVirtualizeSegments && FPlatformProperties::RequiresCookedData() && CVarAedificComponentClusters.GetValueOnAnyThread();
+}
+
+bool AAedificSplineContinuum::CanBeInCluster() const
+{
+	// The Actor roots the cluster of its own components rather than joining its level's one.
+	return OutputMode != EAedificMeshOutput::Dynamic && !bVirtualizeSegments && !CanBeClusterRoot();
+}
+
+void AAedificSplineContinuum::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Only game worlds virtualize their segments, the editor displays all of them.
+	if (bVirtualizeSegments && OutputMode == EAedificMeshOutput::SplineMeshes)
+	{
+		if (UAedificRebuildSubsystem* RebuildSubsystem = GetRebuildSubsystem(); RebuildSubsystem && GetWorld()->IsGameWorld())
+		{
+			bVirtualizationActive = true;
+			bVirtualizationRequested = true;
+			RebuildSubsystem->RegisterVirtualizedContinuum(this);
+		}
+	}
+}
+
+void AAedificSplineContinuum::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bVirtualizationActive)
+	{
+		if (UAedificRebuildSubsystem* RebuildSubsystem = GetRebuildSubsystem())
+		{
+			RebuildSubsystem->UnregisterVirtualizedContinuum(this);
+		}
+
+		bVirtualizationActive = false;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AAedificSplineContinuum::Destroyed()
 {
-	//@TODO: Manually set Garbage Collection Cluster.
+	// The components are about to be destroyed, they can't stay in a cluster.
+	DissolveComponentCluster();
+
+#if WITH_EDITOR
+	// Streaming chunks are separate actors, they'd otherwise outlive the continuum.
+	if (!GetWorld() || !GetWorld()->IsGameWorld())
+	{
+		TruncateStreamingChunks(0);
+	}
+#endif // WITH_EDITOR
+
+	Super::Destroyed();
+}
 
+void AAedificSplineContinuum::OnConstruction(const FTransform& Transform)
+{
+	// Loaded clusters are created by the loader, spawned Actors get theirs once their first rebuild finishes.
 	if (bAutoComputeSpline)
 	{
 		ComputeSpline();
@@ -125,6 +385,9 @@ void AAedificSplineContinuum::OnConstruction(const FTransform& Transform)
 
 void AAedificSplineContinuum::ComputeSpline()
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::ComputeSpline);
+	SCOPE_CYCLE_COUNTER(STAT_AedificComputeSpline);
+
 	UWorld* World = GetWorld();
 	if (!World || !World->IsInitialized() || !SplineComponent)
 	{
@@ -154,6 +417,9 @@ void AAedificSplineContinuum::ComputeSpline()
 
 void AAedificSplineContinuum::ComputeTangents(const int32 SplinePointsNum, const bool bClosed)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::ComputeTangents);
+	SCOPE_CYCLE_COUNTER(STAT_AedificComputeTangents);
+
 	// Cache all point locations to avoid redundant lookups.
 	TArray<FVector> PointLocations;
 	PointLocations.Reserve(SplinePointsNum);
@@ -162,57 +428,24 @@ void AAedificSplineContinuum::ComputeTangents(const int32 SplinePointsNum, const
 		PointLocations.Add(SplineComponent->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::Local));
 	}
 
-	// Iterate through cached points to compute tangents.
-	for (int32 i = 0; i < SplinePointsNum; ++i)
-	{
-		const FVector& CurrentPoint = PointLocations[i];
-		FVector PreviousPoint, NextPoint;
-
-		// Determine neighboring points based on loop type and position.
-		if (bClosed)
-		{
-			PreviousPoint = PointLocations[(i == 0) ? SplinePointsNum - 1 : i - 1];
-			NextPoint = PointLocations[(i == SplinePointsNum - 1) ? 0 : i + 1];
-		}
-		else
-		{
-			PreviousPoint = (i > 0) ? PointLocations[i - 1] : CurrentPoint;
-			NextPoint = (i < SplinePointsNum - 1) ? PointLocations[i + 1] : CurrentPoint;
-		}
+	TArray<FVector> ArriveTangents;
+	TArray<FVector> LeaveTangents;
+	ArriveTangents.SetNumUninitialized(SplinePointsNum);
+	LeaveTangents.SetNumUninitialized(SplinePointsNum);
 
-		FVector Incoming = FVector::ZeroVector;
-		FVector Outgoing = FVector::ZeroVector;
-
-		// Calculate tangent vectors.
-		if ((i > 0 && i < SplinePointsNum - 1) || bClosed)
-		{
-			// Interior point or closed spline become unified direction (Catmull-Rom style).
-			const FVector UnifiedDir = (NextPoint - PreviousPoint).GetSafeNormal();
-
-			Incoming = UnifiedDir * (CurrentPoint - PreviousPoint).Size() * TangentsScale;
-			Outgoing = UnifiedDir * (NextPoint - CurrentPoint).Size() * TangentsScale;
-		}
-		else
-		{
-			// Endpoints of an open spline become one-sided tangents.
-			if (i > 0)
-			{
-				const FVector IncomingDir = (CurrentPoint - PreviousPoint).GetSafeNormal();
-				Incoming = IncomingDir * (CurrentPoint - PreviousPoint).Size() * TangentsScale;
-			}
-			if (i < SplinePointsNum - 1)
-			{
-				const FVector OutgoingDir = (NextPoint - CurrentPoint).GetSafeNormal();
-				Outgoing = OutgoingDir * (NextPoint - CurrentPoint).Size() * TangentsScale;
-			}
-		}
+	FAedificSplineMath::ComputeTangents(PointLocations, bClosed, TangentsScale, ArriveTangents, LeaveTangents);
 
-		SplineComponent->SetTangentsAtSplinePoint(i, Incoming, Outgoing, ESplineCoordinateSpace::Local, false);
+	for (int32 i = 0; i < SplinePointsNum; ++i)
+	{
+		SplineComponent->SetTangentsAtSplinePoint(i, ArriveTangents[i], LeaveTangents[i], ESplineCoordinateSpace::Local, false);
 	}
 }
 
 void AAedificSplineContinuum::ComputeUpVectors(const int32 SplinePointsNum)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::ComputeUpVectors);
+	SCOPE_CYCLE_COUNTER(STAT_AedificComputeUpVectors);
+
 	for (int32 i = 0; i < SplinePointsNum; ++i)
 	{
 		// Get the roll value you set in the editor (in degrees).
@@ -226,310 +459,1854 @@ void AAedificSplineContinuum::ComputeUpVectors(const int32 SplinePointsNum)
 	}
 }
 
-void AAedificSplineContinuum::RebuildMesh()
+static bool IsSameSplinePoint(const FSplinePoint& A, const FSplinePoint& B)
+{
+	return A.Type == B.Type
+		&& A.Position.Equals(B.Position)
+		&& A.ArriveTangent.Equals(B.ArriveTangent)
+		&& A.LeaveTangent.Equals(B.LeaveTangent)
+		&& A.Rotation.Equals(B.Rotation)
+		&& A.Scale.Equals(B.Scale);
+}
+
+void AAedificSplineContinuum::RebuildMesh(const bool bForce)
 {
 	UWorld* World = GetWorld();
-	if (!World->IsValidLowLevel() || !World->IsInitialized() || !SplineComponent->IsValidLowLevel() || !StaticMesh->IsValidLowLevel() || bRebuildRequested)
+	if (!World->IsValidLowLevel() || !World->IsInitialized() || !SplineComponent->IsValidLowLevel() || !StaticMesh->IsValidLowLevel())
 	{
 		return;
 	}
 
-	bRebuildRequested = true;
-
-	EmptyMesh();
+	INC_DWORD_STAT(STAT_AedificRebuildsRequested);
 
-	// Avoid cleaning and re-generating the meshes on the same frame.
-	World->GetTimerManager().SetTimerForNextTick([this, World]()
+	// Moves, undo/redo, level loads and unrelated property changes rerun the construction script without changing any input.
+	if (!bForce && !bBakeRequired && IsRebuildComplete() && BuildState.InputHash != 0 && BuildState.InputHash == ComputeInputHash())
 	{
-		if (!World->IsValidLowLevel() || !SplineComponent->IsValidLowLevel() || !StaticMesh->IsValidLowLevel())
+		++AvoidedRebuilds;
+		INC_DWORD_STAT(STAT_AedificRebuildsAvoided);
+
+		if (UAedificRebuildSubsystem* RebuildSubsystem = GetRebuildSubsystem())
 		{
-			bRebuildRequested = false;
-			return;
+			RebuildSubsystem->NotifyRebuildAvoided();
 		}
 
-		// Mesh and spline dimensions.
-		StaticMesh->CalculateExtendedBounds();
-
-		const float MeshLength = StaticMesh->GetBoundingBox().GetExtent().X * 2.f;
-		const float SplineLength = SplineComponent->GetSplineLength();
+		return;
+	}
 
-		if (MeshLength <= KINDA_SMALL_NUMBER || SplineLength <= KINDA_SMALL_NUMBER)
-		{
-			bRebuildRequested = false;
-			return;
-		}
+#if !WITH_EDITOR
+	// Baked meshes can't be regenerated without the editor, keep the ones saved with the Actor.
+	if (OutputMode == EAedificMeshOutput::Baked && BakedMeshComponents.Num() > 0)
+	{
+		return;
+	}
+#endif // !WITH_EDITOR
 
-		// Minimal number of meshes needed to cover the spline.
-		const int32 LoopSize = FMath::Max(1, FMath::CeilToInt(SplineLength / MeshLength));
+	// Commandlets don't tick their worlds, the rebuild runs right away.
+	UAedificRebuildSubsystem* RebuildSubsystem = GetRebuildSubsystem();
+	if (!RebuildSubsystem || IsRunningCommandlet())
+	{
+		StartRebuild();
+		return;
+	}
 
-		if (bUseParallelTransport)
-		{
-			GenerateMeshParallelTransport(MeshLength, SplineLength, LoopSize);
-		}
-		else
-		{
-			GenerateMesh(MeshLength, SplineLength, LoopSize);
-		}
+	bRebuildRequested = true;
 
-		bRebuildRequested = false;
-	});
+	// Avoid cleaning and re-generating the meshes on the same frame, the scheduler starts the rebuild on a later one.
+	RebuildSubsystem->RequestRebuild(this);
 }
 
-static float GetRelativeRoll(USplineComponent* Component, const FRotator& Rotation, const float Distance)
+void AAedificSplineContinuum::SetSplinePointLocation(const int32 Index, const FVector& Location)
 {
-	const FVector ForwardVector = Rotation.UnrotateVector(Component->GetDirectionAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local)).GetSafeNormal();
-	const FVector RightVector = Rotation.UnrotateVector(Component->GetRightVectorAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local)).GetSafeNormal();
-	const FVector UpVector = Rotation.UnrotateVector(Component->GetUpVectorAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::Local)).GetSafeNormal();
-
-	FMatrix Matrix(ForwardVector, RightVector, UpVector, FVector::ZeroVector);
+	if (!SplineComponent || Index < 0 || Index >= SplineComponent->GetNumberOfSplinePoints())
+	{
+		return;
+	}
 
-	return Matrix.Rotator().Roll;
+	SplineComponent->SetLocationAtSplinePoint(Index, Location, ESplineCoordinateSpace::Local, false);
+	RecordSplineEdit(Index);
+	NotifySplinePointsEdited();
 }
 
-void AAedificSplineContinuum::GenerateMesh(const float MeshLength, const float SplineLength, const int32 LoopSize)
+void AAedificSplineContinuum::AddSplinePoint(const FVector& Location)
 {
-	// Prepare container.
-	SplineMeshComponents.Reserve(LoopSize);
-
-	for (int32 i = 0; i < LoopSize; i++)
+	if (!SplineComponent)
 	{
-		const FString SegmentName = FString::Printf(TEXT("SplineMesh%d"), i);
-
-		const float CurrentDistance = i * MeshLength;
-		const float NextDistance = FMath::Min((i + 1) * MeshLength, SplineLength);
-		const float MidPointDistance = CurrentDistance + NextDistance / 2.f;
-		const float CurrentLenght = NextDistance - CurrentDistance;
-
-		const FVector StartLocation = SplineComponent->GetLocationAtDistanceAlongSpline(CurrentDistance, ESplineCoordinateSpace::Local);
-		const FVector EndLocation = SplineComponent->GetLocationAtDistanceAlongSpline(NextDistance, ESplineCoordinateSpace::Local);
+		return;
+	}
 
-		const FVector UpVector = SplineComponent->GetRotationAtDistanceAlongSpline(MidPointDistance, ESplineCoordinateSpace::Local).Quaternion().GetAxisZ();
+	SplineComponent->AddSplinePoint(Location, ESplineCoordinateSpace::Local, false);
+	RecordSplineEdit(SplineComponent->GetNumberOfSplinePoints() - 1);
+	NotifySplinePointsEdited();
+}
 
-		const FVector SplineStartTangent = SplineComponent->GetTangentAtDistanceAlongSpline(CurrentDistance, ESplineCoordinateSpace::Local);
-		const FVector StartTangent = SplineStartTangent.GetSafeNormal() * FMath::Min(SplineStartTangent.Size(), CurrentLenght);
-		const FVector SplineEndTangent = SplineComponent->GetTangentAtDistanceAlongSpline(NextDistance, ESplineCoordinateSpace::Local);
-		const FVector EndTangent = SplineEndTangent.GetSafeNormal() * FMath::Min(SplineEndTangent.Size(), CurrentLenght);;
+void AAedificSplineContinuum::ApplySplineEdits(TConstArrayView<FAedificSplinePointEdit> Edits)
+{
+	if (!SplineComponent || Edits.Num() == 0)
+	{
+		return;
+	}
 
-		const float StartRollDegrees = GetRelativeRoll(SplineComponent, SplineComponent->GetRotationAtDistanceAlongSpline(MidPointDistance, ESplineCoordinateSpace::Local), CurrentDistance);
-		const float EndRollDegrees = GetRelativeRoll(SplineComponent, SplineComponent->GetRotationAtDistanceAlongSpline(MidPointDistance, ESplineCoordinateSpace::Local), NextDistance);
+	// Appended points must be added in order.
+	TArray<const FAedificSplinePointEdit*> SortedEdits;
+	SortedEdits.Reserve(Edits.Num());
+	for (const FAedificSplinePointEdit& Edit : Edits)
+	{
+		SortedEdits.Add(&Edit);
+	}
 
-		// @TODO: Implement proper scaling.
-		const FVector SplineStartScale = SplineComponent->GetScaleAtDistanceAlongSpline(CurrentDistance);
-		const FVector2D StartScale = FVector2D(SplineStartScale.Y, SplineStartScale.Z);
-		const FVector SplineEndScale = SplineComponent->GetScaleAtDistanceAlongSpline(NextDistance);
-		const FVector2D EndScale = FVector2D(SplineEndScale.Y, SplineEndScale.Z);
+	SortedEdits.Sort([](const FAedificSplinePointEdit& A, const FAedificSplinePointEdit& B) { return A.PointIndex < B.PointIndex; });
 
-		FAedificMeshSegment Segment;
-		Segment.SegmentName			= SegmentName;
-		Segment.StartLocation		= StartLocation;
-		Segment.EndLocation			= EndLocation;
-		Segment.StartTangent		= StartTangent;
-		Segment.EndTangent			= EndTangent;
-		Segment.UpVector			= UpVector;
-		Segment.StartRollDegrees	= StartRollDegrees;
-		Segment.EndRollDegrees		= EndRollDegrees;
-		Segment.StartScale			= StartScale;
-		Segment.EndScale			= EndScale;
+	for (const FAedificSplinePointEdit* Edit : SortedEdits)
+	{
+		// Points appended before this one may not have arrived yet, they stand here until they do.
+		while (SplineComponent->GetNumberOfSplinePoints() <= Edit->PointIndex)
+		{
+			SplineComponent->AddSplinePoint(Edit->Location, ESplineCoordinateSpace::Local, false);
+		}
 
-		CreateSegment(Segment);
+		Edit->Apply(SplineComponent);
 	}
+
+	NotifySplinePointsEdited();
 }
 
-static float CalculateRollInDegrees (const FVector& Tangent, const FVector& Normal, const FVector& ReferenceUpVector)
+void AAedificSplineContinuum::StartRebuild()
 {
-	// Project the ReferenceUpVector onto the plane perpendicular to the tangent.
-	// This gives us the spline mesh's default, non-rolled "up" direction.
-	const FVector DefaultUp = (ReferenceUpVector - Tangent * FVector::DotProduct(ReferenceUpVector, Tangent)).GetSafeNormal();
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::StartRebuild);
+	SCOPE_CYCLE_COUNTER(STAT_AedificStartRebuild);
 
-	// Create an orthonormal basis on that plane with a "right" vector (binormal).
-	const FVector Binormal = FVector::CrossProduct(Tangent, DefaultUp);
+	bRebuildRequested = false;
 
-	// Calculate the angle between the DefaultUp and our desired Normal on that plane.
-	// We get the cosine of the angle from the dot product.
-	const float CosAngle = FVector::DotProduct(DefaultUp, Normal);
+	// Clusters only track the objects present when they're created, the rebuild creates and destroys components.
+	DissolveComponentCluster();
 
-	// We get the sine of the angle by projecting the Normal onto the Binormal.
-	const float SinAngle = FVector::DotProduct(Binormal, Normal);
+	INC_DWORD_STAT(STAT_AedificRebuildsExecuted);
+	++ContinuumStats.NumRebuilds;
 
-	// Use Atan2 to find the angle in radians and convert to degrees.
-	return -FMath::RadiansToDegrees(FMath::Atan2(SinAngle, CosAngle));
-};
+	const double StartTime = FPlatformTime::Seconds();
 
-void AAedificSplineContinuum::GenerateMeshParallelTransport(const float MeshLength, const float SplineLength, const int32 LoopSize)
-{
-	// Determine the number of points (frames) to generate. For N segments, we need N+1 points.
-	const int32 NumFrames = LoopSize + 1;
+	if (!GetWorld() || !SplineComponent->IsValidLowLevel() || !StaticMesh->IsValidLowLevel())
+	{
+		NotifyRebuildFinished();
+		return;
+	}
 
-	// Calculate the distance between each frame along the spline.
-	const float Spacing = SplineLength / (float)LoopSize;
+	// Every generator samples the spline through the same arc-length table.
+	SplineSampler.Build(SplineComponent);
 
-	// Sample positions and tangents at evenly spaced distances along the spline.
-	// These will form the "spine" for our generated meshes.
-	TArray<FVector> Positions; Positions.SetNumUninitialized(NumFrames);
-	TArray<FVector> Tangents;  Tangents.SetNumUninitialized(NumFrames);
+	// Mesh and spline dimensions.
+	StaticMesh->CalculateExtendedBounds();
 
-	for (int32 k = 0; k < NumFrames; ++k)
+#if WITH_EDITOR
+	// Interactive edits only get a coarse preview, the full rebuild runs once the edit ends.
+	const bool bPreview = bInteractiveEdit;
+#else
+	const bool bPreview = false;
+#endif // WITH_EDITOR
+
+	const float MeshLength = StaticMesh->GetBoundingBox().GetExtent().X * 2.f * (bPreview ? FMath::Max(CVarAedificPreviewCoarseness.GetValueOnGameThread(), 1.f) : 1.f);
+	const float SplineLength = SplineSampler.GetLength();
+
+	if (MeshLength <= KINDA_SMALL_NUMBER || SplineLength <= KINDA_SMALL_NUMBER)
 	{
-		const float Dist = k * Spacing;
-		// We don't need to clamp here as k * Spacing will not exceed SplineLength.
-		Positions[k] = SplineComponent->GetLocationAtDistanceAlongSpline(Dist, ESplineCoordinateSpace::Local);
-		Tangents[k] = SplineComponent->GetTangentAtDistanceAlongSpline(Dist, ESplineCoordinateSpace::Local).GetSafeNormal();
+		NotifyRebuildFinished();
+		return;
+	}
+
+	// Segments displayed by a preview are all re-applied with their full settings.
+	if (bPreviewBuilt && !bPreview)
+	{
+		MeshSegments.Reset();
+		BuildState.Reset();
 	}
 
-	// Build normals using Parallel Transport to create smooth, twist-free orientation frames.
-	TArray<FVector> Normals; Normals.SetNumUninitialized(NumFrames);
-	FVector InitialUp = FVector::UpVector; // Define an initial "up" direction.
+	// Minimal number of meshes needed to cover the spline. Adaptive segmentation replaces it with its own count.
+	const int32 LoopSize = FMath::Max(1, FMath::CeilToInt(SplineLength / MeshLength));
 
-	// The first normal is calculated by making the InitialUp vector orthogonal to the first tangent.
-	Normals[0] = (InitialUp - Tangents[0] * FVector::DotProduct(InitialUp, Tangents[0])).GetSafeNormal();
+	// Only the part of the spline that changed since the last build needs to be regenerated.
+	const FAedificDirtyRange DirtyRange = FindDirtyRange(MeshLength, SplineLength);
 
-	for (int32 k = 1; k < NumFrames; ++k)
+	if (OutputMode == EAedificMeshOutput::Scattered)
 	{
-		const FVector PrevTangent = Tangents[k - 1];
-		const FVector CurrentTangent = Tangents[k];
+		CancelPendingBuild();
 
-		// Calculate the rotation that transforms the previous tangent to the current one.
-		const FQuat DeltaRotation = FQuat::FindBetweenNormals(PrevTangent, CurrentTangent);
+		ScatterMesh(MeshLength, SplineLength);
+		FinishRebuild(LoopSize, DirtyRange, CaptureBuildState(MeshLength, SplineLength), bPreview);
 
-		// Apply this rotation to the previous normal to get the new normal.
-		Normals[k] = DeltaRotation.RotateVector(Normals[k - 1]);
+		ContinuumStats.GameThreadTime += FPlatformTime::Seconds() - StartTime;
+	}
+	else
+	{
+		// Generation is accounted as worker time, even when it runs synchronously.
+		ContinuumStats.GameThreadTime += FPlatformTime::Seconds() - StartTime;
 
-		// Re-orthonormalize to prevent floating-point drift from accumulating.
-		Normals[k] = (Normals[k] - CurrentTangent * FVector::DotProduct(Normals[k], CurrentTangent)).GetSafeNormal();
+		LaunchSegmentBuild(MeshLength, SplineLength, LoopSize, DirtyRange, bPreview);
 	}
+}
 
-	// If the spline is a closed loop, distribute the accumulated rotational error.
-	if (SplineComponent->IsClosedLoop())
+bool AAedificSplineContinuum::StartBatchRebuild(const bool bForce)
+{
+	UWorld* World = GetWorld();
+	if (!World || !World->IsInitialized() || !SplineComponent || !StaticMesh)
 	{
-		// The start and end tangents are identical, but floating point errors can cause the normals to drift.
-		const FVector LastNormal = Normals.Last();
-		const FVector FirstNormal = Normals[0];
+		return false;
+	}
 
-		// Calculate the total correction rotation needed to align the last normal with the first.
-		const FQuat TotalCorrection = FQuat::FindBetweenNormals(LastNormal, FirstNormal);
+	if (bAutoComputeSpline)
+	{
+		ComputeSpline();
+	}
 
-		// Apply the correction incrementally along the spline using Slerp.
-		for (int32 j = 0; j < NumFrames; ++j)
-		{
-			const float Alpha = (float)j / (float)(NumFrames - 1);
-			const FQuat StepCorrection = FQuat::Slerp(FQuat::Identity, TotalCorrection, Alpha);
+	if (!bForce && !bBakeRequired && IsRebuildComplete() && BuildState.InputHash != 0 && BuildState.InputHash == ComputeInputHash())
+	{
+		++AvoidedRebuilds;
+		INC_DWORD_STAT(STAT_AedificRebuildsAvoided);
+		return false;
+	}
 
-			Normals[j] = StepCorrection.RotateVector(Normals[j]);
+	INC_DWORD_STAT(STAT_AedificRebuildsRequested);
 
-			// Re-orthonormalize one last time.
-			const FVector Tj = Tangents[j];
-			Normals[j] = (Normals[j] - Tj * FVector::DotProduct(Normals[j], Tj)).GetSafeNormal();
-		}
+	bBatchRebuild = true;
+	StartRebuild();
+
+	return true;
+}
+
+void AAedificSplineContinuum::FinishBatchRebuild()
+{
+	if (!bBatchRebuild)
+	{
+		return;
 	}
 
-	// Spawn SplineMeshComponents using the generated frames.
-	// Each segment 'i' uses frame 'i' for its start and frame 'i+1' for its end.
-	SplineMeshComponents.Reset(LoopSize);
+	bBatchRebuild = false;
 
-	for (int32 i = 0; i < LoopSize; ++i)
+	BatchBuildTask.Wait();
+	BatchBuildTask = UE::Tasks::FTask();
+
+	// Scattered meshes, and builds that had nothing to generate, are already finished.
+	if (PendingBuild.IsValid())
+	{
+		ApplySegmentBuild(PendingBuild.ToSharedRef());
+	}
+}
+
+bool AAedificSplineContinuum::IsBuildOutdated() const
+{
+	if (!SplineComponent || !StaticMesh || !IsRebuildComplete())
 	{
-		const int32 StartIndex = i;
-		const int32 EndIndex = i + 1;
+		return false;
+	}
+
+	return BuildState.InputHash == 0 || BuildState.InputHash != ComputeInputHash();
+}
 
-		const FVector StartTangentVec = Tangents[StartIndex];
-		const FVector EndTangentVec = Tangents[EndIndex];
-		const FVector StartNormalVec = Normals[StartIndex];
-		const FVector EndNormalVec = Normals[EndIndex];
+uint64 AAedificSplineContinuum::ComputeInputHash() const
+{
+	FXxHash64Builder Builder;
 
-		// The single "UpVector" for SetSplineUpDir acts as a reference frame.
-		// Averaging the start and end normals is a reasonable choice for this reference.
-		const FVector ReferenceUp = (StartNormalVec + EndNormalVec).GetSafeNormal();
+	// Only scalars are hashed as raw bytes, the padding of structs is indeterminate and would make the hash unstable.
+	auto Hash = [&Builder](const auto& Value)
+	{
+		using FValueType = std::decay_t<decltype(Value)>;
+		static_assert(std::is_floating_point_v<FValueType> || std::has_unique_object_representations_v<FValueType>, "Hash the members of the struct instead.");
+		Builder.Update(&Value, sizeof(Value));
+	};
+	auto HashVector = [&Hash](const FVector& Vector)
+	{
+		Hash(Vector.X);
+		Hash(Vector.Y);
+		Hash(Vector.Z);
+	};
+	auto HashName = [&Builder](const UObject* Object)
+	{
+		const FString PathName = Object ? Object->GetPathName() : FString();
+		Builder.Update(*PathName, PathName.Len() * sizeof(TCHAR));
+	};
 
-		// The magnitude of the tangent for a spline mesh controls its curvature.
-		// A good default is the distance between the points.
-		const float TangentMagnitude = (Positions[EndIndex] - Positions[StartIndex]).Size();
+	// Spline, in local space so the Actor's transform doesn't matter.
+	const int32 SplinePointsNum = SplineComponent->GetNumberOfSplinePoints();
+	Hash(SplinePointsNum);
 
-		// @TODO: Combine with user inputed Spline rotation.
-		// Calculate the roll needed at the start and end of the segment.
-		const float StartRoll = CalculateRollInDegrees(StartTangentVec, StartNormalVec, ReferenceUp);
-		const float EndRoll = CalculateRollInDegrees(EndTangentVec, EndNormalVec, ReferenceUp);
+	for (int32 i = 0; i < SplinePointsNum; ++i)
+	{
+		const FSplinePoint Point = SplineComponent->GetSplinePointAt(i, ESplineCoordinateSpace::Local);
+		Hash(Point.InputKey);
+		HashVector(Point.Position);
+		HashVector(Point.ArriveTangent);
+		HashVector(Point.LeaveTangent);
+		Hash(Point.Rotation.Pitch);
+		Hash(Point.Rotation.Yaw);
+		Hash(Point.Rotation.Roll);
+		HashVector(Point.Scale);
+		Hash(Point.Type);
+		HashVector(SplineComponent->GetUpVectorAtSplinePoint(i, ESplineCoordinateSpace::Local));
+	}
 
-		FAedificMeshSegment Segment;
-		Segment.SegmentName			= FString::Printf(TEXT("SplineMesh%d"), i);
-		Segment.UpVector			= ReferenceUp; // For SetSplineUpDir()
-		Segment.StartLocation		= Positions[StartIndex];
-		Segment.StartTangent		= StartTangentVec * TangentMagnitude;
-		Segment.EndLocation			= Positions[EndIndex];
-		Segment.EndTangent			= EndTangentVec * TangentMagnitude;
-		Segment.StartRollDegrees	= StartRoll;
-		Segment.EndRollDegrees		= EndRoll;
+	HashVector(SplineComponent->DefaultUpVector);
+	Hash((uint8)SplineComponent->IsClosedLoop());
+
+	// Mesh.
+	HashName(StaticMesh);
+	const FBox MeshBounds = StaticMesh ? StaticMesh->GetBoundingBox() : FBox(ForceInit);
+	HashVector(MeshBounds.Min);
+	HashVector(MeshBounds.Max);
+	Hash(MeshBounds.IsValid);
+	HashName(MaterialOverride);
+
+	// Generator settings.
+	Hash((uint8)bAutoComputeSpline);
+	Hash((uint8)bComputeTangents);
+	Hash(TangentsScale);
+	Hash((uint8)bComputeUpVectors);
+	Hash((uint8)bUseParallelTransport);
+	Hash((uint8)bAdaptiveSegmentation);
+	Hash(MaxChordDeviation);
+	Hash(MaxSegmentTwist);
+	Hash(MaxSegmentStretch);
+	Hash(OutputMode);
+	Hash(BakeChunkSize);
+	Hash(DynamicChunkSize);
+	Hash(ScatterSpacing);
 
-		// @TODO: Implement proper scaling.
-		Segment.StartScale	= FVector2D::UnitVector;
-		Segment.EndScale	= FVector2D::UnitVector;
+#if WITH_EDITORONLY_DATA
+	Builder.Update(*BakedMeshDirectory.Path, BakedMeshDirectory.Path.Len() * sizeof(TCHAR));
+	Hash((uint8)bBakeStreamingChunks);
+	Hash(StreamingCellSize);
 
-		CreateSegment(Segment);
+	// Streaming chunks are laid out in world space.
+	if (bBakeStreamingChunks)
+	{
+		const FQuat ActorQuat = GetActorQuat();
+		HashVector(GetActorLocation());
+		Hash(ActorQuat.X);
+		Hash(ActorQuat.Y);
+		Hash(ActorQuat.Z);
+		Hash(ActorQuat.W);
+		HashVector(GetActorScale3D());
 	}
+#endif // WITH_EDITORONLY_DATA
+
+	// 0 is reserved for builds that must never match.
+	return FMath::Max<uint64>(Builder.Finalize().Hash, 1);
 }
 
-void AAedificSplineContinuum::CreateSegment(const FAedificMeshSegment& Segment)
+TSharedPtr<const FAedificSegmentIndex> AAedificSplineContinuum::GetSegmentIndex()
 {
-	// Create & configure spline mesh component.
-	USplineMeshComponent* NewMeshSegment = NewObject<USplineMeshComponent>(this, USplineMeshComponent::StaticClass(),
-		*Segment.SegmentName, EObjectFlags::RF_Transactional);
-	NewMeshSegment->CreationMethod = EComponentCreationMethod::UserConstructionScript;
-	NewMeshSegment->RegisterComponent();
-	NewMeshSegment->AttachToComponent(RootComponent, FAttachmentTransformRules::FAttachmentTransformRules(EAttachmentRule::KeepRelative, true));
+	check(IsInGameThread());
 
-	NewMeshSegment->SetMobility(EComponentMobility::Static);
-	NewMeshSegment->SetComponentTickEnabled(false);
-	NewMeshSegment->SetGenerateOverlapEvents(false);
-	NewMeshSegment->bComputeFastLocalBounds = true;
-	NewMeshSegment->bComputeBoundsOnceForGame = true;
-	NewMeshSegment->SetCollisionEnabled(ECollisionEnabled::QueryAndProbe);
+	UpdateSegmentIndex();
+	return SegmentIndex;
+}
+
+TSharedPtr<const FAedificFollowerTrack> AAedificSplineContinuum::GetFollowerTrack()
+{
+	check(IsInGameThread());
 
-	if (StaticMesh)
+	if (!FollowerTrack.IsValid() || !FollowerTrack->GetTransform().Equals(GetActorTransform()))
 	{
-		NewMeshSegment->SetStaticMesh(StaticMesh);
+		UpdateFollowerTrack();
 	}
 
-	NewMeshSegment->SetStartAndEnd(Segment.StartLocation, Segment.StartTangent, Segment.EndLocation, Segment.EndTangent, false);
-	NewMeshSegment->SetSplineUpDir(Segment.UpVector, false);
-	NewMeshSegment->SetStartRollDegrees(Segment.StartRollDegrees, false);
-	NewMeshSegment->SetEndRollDegrees(Segment.EndRollDegrees, false);
-	NewMeshSegment->SetStartScale(Segment.StartScale, false);
-	NewMeshSegment->SetEndScale(Segment.EndScale, false);
+	return FollowerTrack;
+}
 
-	if (MaterialOverride)
+void AAedificSplineContinuum::CreateComponentCluster()
+{
+	const UWorld* World = GetWorld();
+	if (!World || !World->IsGameWorld() || !IsValid(this) || !CanBeClusterRoot() || IsComponentClusterRoot())
+	{
+		return;
+	}
+
+	// Objects already belonging to another cluster can't root their own.
+	const FUObjectItem* ObjectItem = GUObjectArray.ObjectToObjectItem(this);
+	if (!ObjectItem || ObjectItem->GetOwnerIndex() != 0)
 	{
-		NewMeshSegment->SetMaterial(0, MaterialOverride);
+		return;
 	}
 
-	NewMeshSegment->UpdateMesh();
+	CreateCluster();
+}
 
-	SplineMeshComponents.AddUnique(NewMeshSegment);
+void AAedificSplineContinuum::DissolveComponentCluster()
+{
+	if (IsComponentClusterRoot())
+	{
+		GUObjectClusters.DissolveCluster(this);
+	}
 }
 
-void AAedificSplineContinuum::EmptyMesh()
+#if WITH_EDITOR
+void AAedificSplineContinuum::NotifyEdited(const bool bInteractive)
 {
-	if (SplineMeshComponents.Num() > 0)
+	if (bInteractive)
 	{
-		for (USplineMeshComponent* Mesh : SplineMeshComponents)
+		LastInteractiveEditTime = FPlatformTime::Seconds();
+
+		if (!bInteractiveEdit)
 		{
-			if (Mesh->IsValidLowLevelFast())
+			bInteractiveEdit = true;
+
+			if (UAedificRebuildSubsystem* RebuildSubsystem = GetRebuildSubsystem())
 			{
-				Mesh->DestroyComponent();
+				RebuildSubsystem->NotifyInteractiveEdit(this);
 			}
 		}
+	}
+	else if (bInteractiveEdit)
+	{
+		// The edit ended, replace the preview with a full rebuild.
+		bInteractiveEdit = false;
+
+		if (bAutoRebuildMesh)
+		{
+			RebuildMesh();
+		}
+	}
+}
+#endif // WITH_EDITOR
 
-		SplineMeshComponents.Reset();
+UAedificRebuildSubsystem* AAedificSplineContinuum::GetRebuildSubsystem() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UAedificRebuildSubsystem>() : nullptr;
+}
 
-		// @TODO: Bake spline mesh segments into one single static mesh to reduce draw-calls.
+void AAedificSplineContinuum::NotifyRebuildFinished()
+{
+	if (UAedificRebuildSubsystem* RebuildSubsystem = GetRebuildSubsystem())
+	{
+		ContinuumStats.MaxLatency = FMath::Max(ContinuumStats.MaxLatency, RebuildSubsystem->NotifyRebuildFinished(this));
 	}
 }
 
-void AAedificSplineContinuum::UpdateMaterial()
+void AAedificSplineContinuum::UpdateSegmentIndex()
 {
-	if (SplineMeshComponents.Num() > 0)
+	const FTransform& Transform = GetActorTransform();
+
+	// Radius of the mesh around the spline, which deforms along its X axis.
+	const FVector MeshExtent = StaticMesh ? StaticMesh->GetBoundingBox().GetExtent() : FVector::ZeroVector;
+	const float CrossSectionRadius = (float)FVector2D(MeshExtent.Y, MeshExtent.Z).Size();
+
+	if (!SegmentIndex.IsValid() || SegmentIndex->GetNumSegments() != MeshSegments.Num() || SegmentIndex->GetCrossSectionRadius() != CrossSectionRadius
+		|| !SegmentIndex->GetTransform().Equals(Transform))
 	{
-		for (USplineMeshComponent* Mesh : SplineMeshComponents)
+		// Snapshots already handed out stay as they are, a new one replaces them.
+		TSharedPtr<FAedificSegmentIndex> NewIndex = MakeShared<FAedificSegmentIndex>();
+		NewIndex->Build(MeshSegments, Transform, CrossSectionRadius);
+		SegmentIndex = NewIndex;
+	}
+	else if (FirstUnindexedSegment <= LastUnindexedSegment)
+	{
+		// Refitted in place, unless a snapshot is still being queried somewhere else.
+		if (!SegmentIndex.IsUnique())
 		{
-			if (MaterialOverride)
+			SegmentIndex = MakeShared<FAedificSegmentIndex>(*SegmentIndex);
+		}
+
+		SegmentIndex->Refit(MeshSegments, FirstUnindexedSegment, LastUnindexedSegment);
+	}
+
+	FirstUnindexedSegment = MAX_int32;
+	LastUnindexedSegment = INDEX_NONE;
+}
+
+void AAedificSplineContinuum::UpdateFollowerTrack()
+{
+	// Followers still holding the previous track keep using it until they're given this one.
+	TSharedPtr<FAedificFollowerTrack> NewTrack = MakeShared<FAedificFollowerTrack>();
+	NewTrack->Build(MeshSegments, GetActorTransform(), SplineComponent && SplineComponent->IsClosedLoop());
+	FollowerTrack = NewTrack;
+}
+
+void AAedificSplineContinuum::NotifySplinePointsEdited()
+{
+	// Computed tangents only change around the edited point, so the rebuild's dirty range stays local to the edit.
+	if (bAutoComputeSpline && SplineComponent->GetNumberOfSplinePoints() >= 2)
+	{
+		ComputeSpline();
+	}
+	else
+	{
+		SplineComponent->UpdateSpline();
+	}
+
+	RebuildMesh();
+}
+
+void AAedificSplineContinuum::RecordSplineEdit(const int32 PointIndex)
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	// Points are edited without updating the spline, its tangents would still be the ones from before the edit.
+	SplineComponent->UpdateSpline();
+
+	// Computed tangents are computed again by the clients, from the replicated locations.
+	const bool bWithTangents = !bAutoComputeSpline || !bComputeTangents;
+	SplineEdits.RecordPoint(SplineComponent, PointIndex, bWithTangents).Apply(SplineComponent);
+
+	if (GetNetMode() != NM_Standalone)
+	{
+		FlushNetDormancy();
+	}
+}
+
+void AAedificSplineContinuum::LaunchSegmentBuild(const float MeshLength, const float SplineLength, const int32 LoopSize, const FAedificDirtyRange& DirtyRange, const bool bPreview)
+{
+	// A newer build always supersedes the one still running.
+	CancelPendingBuild();
+
+	// The build only works on copies, the Actor and its spline can keep changing while it runs.
+	TSharedRef<FAedificSegmentBuild> Build = MakeShared<FAedificSegmentBuild>();
+	Build->Sampler = SplineSampler;
+	Build->MeshLength = MeshLength;
+	Build->SplineLength = SplineLength;
+	Build->LoopSize = LoopSize;
+	Build->DirtyRange = DirtyRange;
+	Build->bPreview = bPreview;
+	Build->PreviousSegments = MeshSegments;
+	Build->State = CaptureBuildState(MeshLength, SplineLength);
+
+	PendingBuild = Build;
+
+	// Batch rebuilds are applied by FinishBatchRebuild, once every Actor of the batch is launched.
+	if (bBatchRebuild)
+	{
+		BatchBuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Build]()
+		{
+			FAedificSegmentBuilder::Build(*Build);
+		});
+
+		return;
+	}
+
+	// Commandlets expect the meshes to be up to date as soon as the rebuild runs.
+	if (!CVarAedificAsyncRebuild.GetValueOnGameThread() || IsRunningCommandlet())
+	{
+		FAedificSegmentBuilder::Build(*Build);
+		ApplySegmentBuild(Build);
+		return;
+	}
+
+	TWeakObjectPtr<AAedificSplineContinuum> WeakThis(this);
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Build]()
+	{
+		if (!FAedificSegmentBuilder::Build(*Build))
+		{
+			return;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Build]()
+		{
+			if (AAedificSplineContinuum* Continuum = WeakThis.Get())
+			{
+				Continuum->ApplySegmentBuild(Build);
+			}
+		});
+	});
+}
+
+void AAedificSplineContinuum::ApplySegmentBuild(const TSharedRef<FAedificSegmentBuild>& Build)
+{
+	// Results of a superseded build are stale, the newer one applies its own.
+	if (Build->bCancelled || PendingBuild != Build)
+	{
+		UE_LOG(LogAedific, Verbose, TEXT("%s: Discarded a stale segment build."), *GetName());
+		return;
+	}
+
+	PendingBuild.Reset();
+
+	ContinuumStats.WorkerTime += Build->BuildTime;
+
+	MaterializingBuild = Build;
+	MaterializationQueue.SetNumUninitialized(Build->Segments.Num());
+	NextMaterializedSegment = 0;
+
+	for (int32 i = 0; i < MaterializationQueue.Num(); ++i)
+	{
+		MaterializationQueue[i] = i;
+	}
+
+	// Only spline mesh components are worth spreading over several frames, other outputs need their segments in order.
+	FVector FocusLocation;
+	if (OutputMode == EAedificMeshOutput::SplineMeshes && GetMaterializationFocus(*Build, FocusLocation))
+	{
+		TArray<double> FocusDistances;
+		FocusDistances.SetNumUninitialized(Build->Segments.Num());
+
+		for (int32 i = 0; i < FocusDistances.Num(); ++i)
+		{
+			const FAedificMeshSegment& Segment = Build->Segments[i];
+			FocusDistances[i] = FVector::DistSquared((Segment.StartLocation + Segment.EndLocation) * 0.5, FocusLocation);
+		}
+
+		MaterializationQueue.Sort([&FocusDistances](const int32 A, const int32 B) { return FocusDistances[A] < FocusDistances[B]; });
+	}
+
+	// The scheduler applies the segments under its frame budget, commandlets apply them right away.
+	UAedificRebuildSubsystem* RebuildSubsystem = GetRebuildSubsystem();
+	if (!RebuildSubsystem || IsRunningCommandlet())
+	{
+		MaterializeSegments(0.0);
+		return;
+	}
+
+	RebuildSubsystem->RequestMaterialization(this);
+}
+
+bool AAedificSplineContinuum::GetMaterializationFocus(const FAedificSegmentBuild& Build, FVector& OutLocation) const
+{
+	// Segments around the edit come first.
+	if (!Build.DirtyRange.bFullRebuild && !Build.DirtyRange.IsEmpty())
+	{
+		const float EndDistance = FMath::Min(Build.DirtyRange.EndDistance, Build.SplineLength);
+		OutLocation = Build.Sampler.SampleAtDistance((Build.DirtyRange.StartDistance + EndDistance) * 0.5f).Location;
+		return true;
+	}
+
+	// Otherwise, the ones nearest to the viewer.
+	const UWorld* World = GetWorld();
+	if (World && World->ViewLocationsRenderedLastFrame.Num() > 0)
+	{
+		OutLocation = GetActorTransform().InverseTransformPosition(World->ViewLocationsRenderedLastFrame[0]);
+		return true;
+	}
+
+	return false;
+}
+
+bool AAedificSplineContinuum::MaterializeSegments(const double EndTime)
+{
+	if (!MaterializingBuild.IsValid())
+	{
+		return true;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::MaterializeSegments);
+	SCOPE_CYCLE_COUNTER(STAT_AedificMaterializeSegments);
+
+	const double StartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT { ContinuumStats.GameThreadTime += FPlatformTime::Seconds() - StartTime; };
+
+	// Outputs without per-segment components apply everything at once.
+	const bool bTimeSliced = EndTime > 0.0 && OutputMode == EAedificMeshOutput::SplineMeshes;
+
+	const FAedificSegmentBuild& Build = *MaterializingBuild;
+
+	while (NextMaterializedSegment < MaterializationQueue.Num())
+	{
+		const int32 Index = MaterializationQueue[NextMaterializedSegment++];
+		CreateSegment(Index, Build.Segments[Index]);
+
+		if (bTimeSliced && FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+	}
+
+	// Continue on a later frame, the segments not applied yet keep displaying the previous build.
+	if (NextMaterializedSegment < MaterializationQueue.Num())
+	{
+		return false;
+	}
+
+	const TSharedRef<FAedificSegmentBuild> FinishedBuild = MaterializingBuild.ToSharedRef();
+	MaterializingBuild.Reset();
+	MaterializationQueue.Reset();
+	NextMaterializedSegment = 0;
+
+	FinishRebuild(FinishedBuild->LoopSize, FinishedBuild->DirtyRange, MoveTemp(FinishedBuild->State), FinishedBuild->bPreview);
+
+	return true;
+}
+
+void AAedificSplineContinuum::CancelPendingBuild()
+{
+	if (PendingBuild.IsValid())
+	{
+		PendingBuild->bCancelled = true;
+		PendingBuild.Reset();
+	}
+
+	// Segments already applied stay as they are, the next build re-targets or releases them.
+	if (MaterializingBuild.IsValid())
+	{
+		// The displayed segments now mix both builds and match neither build state, so the next build must regenerate
+		// all of them, even if the spline returns to its previous state.
+		if (NextMaterializedSegment > 0)
+		{
+			BuildState.Reset();
+		}
+
+		MaterializingBuild.Reset();
+		MaterializationQueue.Reset();
+		NextMaterializedSegment = 0;
+	}
+}
+
+float AAedificSplineContinuum::GetRebuildProgress() const
+{
+	if (MaterializingBuild.IsValid())
+	{
+		return (MaterializationQueue.Num() > 0) ? (float)NextMaterializedSegment / (float)MaterializationQueue.Num() : 1.f;
+	}
+
+	return IsRebuildComplete() ? 1.f : 0.f;
+}
+
+void AAedificSplineContinuum::FinishRebuild(const int32 LoopSize, const FAedificDirtyRange& DirtyRange, FAedificMeshBuildState&& State, const bool bPreview)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::FinishRebuild);
+	SCOPE_CYCLE_COUNTER(STAT_AedificFinishRebuild);
+
+	// Outputs of a previous mode are only removed once the new one is ready, so nothing disappears in between.
+	EmptyUnusedOutputs();
+
+	// Segments left over from a longer previous build go back to the pool.
+	ReleaseSegments(LoopSize);
+
+	if (MeshSegments.Num() > LoopSize)
+	{
+		MeshSegments.SetNum(LoopSize);
+		bBakeRequired = true;
+	}
+
+	// Baking is far too slow for interactive edits, the last bake stays displayed until the edit ends.
+	if (OutputMode == EAedificMeshOutput::Baked && !bPreview)
+	{
+		BakeMesh();
+	}
+	else if (OutputMode == EAedificMeshOutput::Instanced)
+	{
+		UpdateInstancedMesh(LoopSize);
+	}
+	else if (OutputMode == EAedificMeshOutput::Dynamic)
+	{
+		UpdateDynamicMesh();
+	}
+
+	BuildState = MoveTemp(State);
+	bPreviewBuilt = bPreview;
+
+	// Previews must never short-circuit the full rebuild following them.
+	if (bPreview)
+	{
+		BuildState.InputHash = 0;
+	}
+
+	// Only kept up to date once something queried it.
+	if (SegmentIndex.IsValid())
+	{
+		UpdateSegmentIndex();
+	}
+
+	if (FollowerTrack.IsValid())
+	{
+		UpdateFollowerTrack();
+	}
+
+	CreateComponentCluster();
+
+	UE_LOG(LogAedific, Verbose, TEXT("%s: Rebuilt %d segments (dirty range: %s, total pool hits: %u, misses: %u, pooled: %d)."),
+		*GetName(), LoopSize, DirtyRange.bFullRebuild ? TEXT("full") : *FString::Printf(TEXT("%.1f-%.1f"), DirtyRange.StartDistance, DirtyRange.EndDistance),
+		PoolHits, PoolMisses, PooledSplineMeshComponents.Num());
+
+	NotifyRebuildFinished();
+}
+
+FAedificSegmentation AAedificSplineContinuum::GetSegmentation() const
+{
+	FAedificSegmentation Segmentation;
+	Segmentation.bAdaptive = bAdaptiveSegmentation;
+	Segmentation.MaxChordDeviation = FMath::Max(MaxChordDeviation, 0.1f);
+	Segmentation.MaxTwistDegrees = MaxSegmentTwist;
+	Segmentation.MaxStretch = FMath::Max(MaxSegmentStretch, 1.f);
+
+	return Segmentation;
+}
+
+FAedificDirtyRange AAedificSplineContinuum::FindDirtyRange(const float MeshLength, const float SplineLength) const
+{
+	FAedificDirtyRange DirtyRange;
+
+	const int32 SplinePointsNum = SplineComponent->GetNumberOfSplinePoints();
+	const bool bClosed = SplineComponent->IsClosedLoop();
+
+	// Changes on the topology, the mesh or the generator invalidate every segment.
+	if (BuildState.SplinePoints.Num() != SplinePointsNum || BuildState.bClosedLoop != bClosed || BuildState.bParallelTransport != bUseParallelTransport
+		|| !FMath::IsNearlyEqual(BuildState.MeshLength, MeshLength) || BuildState.Segmentation != GetSegmentation() || MeshSegments.Num() == 0)
+	{
+		return DirtyRange;
+	}
+
+	int32 FirstChanged = INDEX_NONE;
+	int32 LastChanged = INDEX_NONE;
+	for (int32 i = 0; i < SplinePointsNum; ++i)
+	{
+		if (!IsSameSplinePoint(SplineComponent->GetSplinePointAt(i, ESplineCoordinateSpace::Local), BuildState.SplinePoints[i]))
+		{
+			FirstChanged = (FirstChanged == INDEX_NONE) ? i : FirstChanged;
+			LastChanged = i;
+		}
+	}
+
+	DirtyRange.bFullRebuild = false;
+	DirtyRange.LengthOffset = SplineLength - BuildState.SplineLength;
+
+	if (FirstChanged == INDEX_NONE)
+	{
+		// Nothing changed, leave an empty range.
+		DirtyRange.StartDistance = MAX_flt;
+		DirtyRange.EndDistance = -MAX_flt;
+		return DirtyRange;
+	}
+
+	// The curve wrapping around a closed loop can't be expressed as a single range.
+	if (bClosed && (FirstChanged == 0 || LastChanged == SplinePointsNum - 1))
+	{
+		DirtyRange.bFullRebuild = true;
+		return DirtyRange;
+	}
+
+	// A point affects the curve sections reaching it from both of its neighbors.
+	DirtyRange.StartDistance = SplineSampler.GetDistanceAtSplinePoint(FMath::Max(FirstChanged - 1, 0));
+	DirtyRange.EndDistance = SplineSampler.GetDistanceAtSplinePoint(FMath::Min(LastChanged + 1, SplinePointsNum - 1));
+
+	return DirtyRange;
+}
+
+FAedificMeshBuildState AAedificSplineContinuum::CaptureBuildState(const float MeshLength, const float SplineLength) const
+{
+	FAedificMeshBuildState State;
+
+	const int32 SplinePointsNum = SplineComponent->GetNumberOfSplinePoints();
+
+	State.SplinePoints.Reset(SplinePointsNum);
+	for (int32 i = 0; i < SplinePointsNum; ++i)
+	{
+		State.SplinePoints.Add(SplineComponent->GetSplinePointAt(i, ESplineCoordinateSpace::Local));
+	}
+
+	State.MeshLength = MeshLength;
+	State.SplineLength = SplineLength;
+	State.bClosedLoop = SplineComponent->IsClosedLoop();
+	State.bParallelTransport = bUseParallelTransport;
+	State.Segmentation = GetSegmentation();
+	State.InputHash = ComputeInputHash();
+
+	// Parallel Transport frames of the last build, to be partially updated by the next one.
+	if (bUseParallelTransport)
+	{
+		State.FramePositions = BuildState.FramePositions;
+		State.FrameTangents = BuildState.FrameTangents;
+		State.FrameNormals = BuildState.FrameNormals;
+	}
+
+	return State;
+}
+
+void AAedificSplineContinuum::CreateSegment(const int32 Index, const FAedificMeshSegment& Segment)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::CreateSegment);
+	SCOPE_CYCLE_COUNTER(STAT_AedificCreateSegment);
+
+	const bool bSegmentChanged = !MeshSegments.IsValidIndex(Index) || !MeshSegments[Index].Equals(Segment);
+
+	if (bSegmentChanged)
+	{
+		INC_DWORD_STAT(STAT_AedificSegmentsApplied);
+		++ContinuumStats.NumSegmentsApplied;
+
+		FirstUnindexedSegment = FMath::Min(FirstUnindexedSegment, Index);
+		LastUnindexedSegment = FMath::Max(LastUnindexedSegment, Index);
+	}
+
+	if (Index >= MeshSegments.Num())
+	{
+		MeshSegments.SetNum(Index + 1);
+	}
+
+#if WITH_EDITOR
+	// Baked output only keeps the segment, the mesh is baked once all of them are generated.
+	if (OutputMode == EAedificMeshOutput::Baked)
+	{
+		bBakeRequired |= bSegmentChanged;
+		MeshSegments[Index] = Segment;
+		return;
+	}
+#endif // WITH_EDITOR
+
+	// Instanced output only updates the segment's packed record, no component gets registered.
+	if (OutputMode == EAedificMeshOutput::Instanced)
+	{
+		UAedificInstancedSplineMeshComponent* InstancedMesh = GetInstancedMeshComponent();
+		if (bSegmentChanged || Index >= InstancedMesh->GetInstanceCount())
+		{
+			InstancedMesh->SetSegment(Index, Segment);
+		}
+
+		MeshSegments[Index] = Segment;
+		return;
+	}
+
+	// Dynamic output only keeps the segment, the chunks holding the changed ones are rebuilt once all of them are generated.
+	if (OutputMode == EAedificMeshOutput::Dynamic)
+	{
+		if (bSegmentChanged)
+		{
+			// The next segment's start seam is welded to this one's end.
+			const int32 ChunkSize = FMath::Max(DynamicChunkSize, 1);
+			DirtyDynamicChunks.Add(Index / ChunkSize);
+			DirtyDynamicChunks.Add((Index + 1) / ChunkSize);
+		}
+
+		MeshSegments[Index] = Segment;
+		return;
+	}
+
+	if (Index >= SplineMeshComponents.Num())
+	{
+		SplineMeshComponents.SetNum(Index + 1);
+	}
+
+	// Re-target the component already living at this index, if it survived since the last build.
+	USplineMeshComponent* MeshSegment = SplineMeshComponents[Index];
+	if (IsValid(MeshSegment) && !MeshSegment->IsBeingDestroyed())
+	{
+		// Leave the component untouched if it already displays this exact segment.
+		if (!bSegmentChanged)
+		{
+			return;
+		}
+
+		++PoolHits;
+	}
+	else if (bVirtualizationActive)
+	{
+		// Virtualized segments only keep their record, the next virtualization update gives them a component if they're in range.
+		SplineMeshComponents[Index] = nullptr;
+		MeshSegments[Index] = Segment;
+		bVirtualizationRequested = true;
+		return;
+	}
+	else
+	{
+		MeshSegment = AcquireSplineMeshComponent(Segment);
+		SplineMeshComponents[Index] = MeshSegment;
+	}
+
+	MeshSegments[Index] = Segment;
+
+	ApplySegment(MeshSegment, Segment);
+}
+
+void AAedificSplineContinuum::ApplySegment(USplineMeshComponent* MeshSegment, const FAedificMeshSegment& Segment)
+{
+	if (StaticMesh && MeshSegment->GetStaticMesh() != StaticMesh)
+	{
+		MeshSegment->SetStaticMesh(StaticMesh);
+	}
+
+	MeshSegment->SetStartAndEnd(Segment.StartLocation, Segment.StartTangent, Segment.EndLocation, Segment.EndTangent, false);
+	MeshSegment->SetSplineUpDir(Segment.UpVector, false);
+	MeshSegment->SetStartRollDegrees(Segment.StartRollDegrees, false);
+	MeshSegment->SetEndRollDegrees(Segment.EndRollDegrees, false);
+	MeshSegment->SetStartScale(Segment.StartScale, false);
+	MeshSegment->SetEndScale(Segment.EndScale, false);
+
+	// Previews skip the collision cooking and material updates, and render the lowest LOD.
+	const bool bPreview = MaterializingBuild.IsValid() && MaterializingBuild->bPreview;
+
+	MeshSegment->SetCollisionEnabled(bPreview ? ECollisionEnabled::NoCollision : ECollisionEnabled::QueryAndProbe);
+	MeshSegment->SetForcedLodModel((bPreview && StaticMesh) ? StaticMesh->GetNumLODs() : 0);
+
+	if (MaterialOverride && !bPreview)
+	{
+		MeshSegment->SetMaterial(0, MaterialOverride);
+	}
+
+	MeshSegment->UpdateMesh();
+}
+
+USplineMeshComponent* AAedificSplineContinuum::AcquireSplineMeshComponent(const FAedificMeshSegment& Segment)
+{
+	// Prefer a pooled component, discarding any that got destroyed behind our back.
+	while (PooledSplineMeshComponents.Num() > 0)
+	{
+		USplineMeshComponent* PooledSegment = PooledSplineMeshComponents.Pop(EAllowShrinking::No);
+		if (IsValid(PooledSegment) && !PooledSegment->IsBeingDestroyed())
+		{
+			PooledSegment->SetVisibility(true);
+			PooledSegment->SetCollisionEnabled(ECollisionEnabled::QueryAndProbe);
+
+			++PoolHits;
+			return PooledSegment;
+		}
+	}
+
+	// Create & configure spline mesh component.
+	// Created as an instance component so re-running the construction script doesn't destroy it and the next build can recycle it.
+	USplineMeshComponent* NewMeshSegment = NewObject<USplineMeshComponent>(this, USplineMeshComponent::StaticClass(),
+		MakeUniqueObjectName(this, USplineMeshComponent::StaticClass(), *Segment.SegmentName), EObjectFlags::RF_Transactional);
+	NewMeshSegment->CreationMethod = EComponentCreationMethod::Instance;
+	NewMeshSegment->RegisterComponent();
+	NewMeshSegment->AttachToComponent(RootComponent, FAttachmentTransformRules::FAttachmentTransformRules(EAttachmentRule::KeepRelative, true));
+
+	NewMeshSegment->SetMobility(EComponentMobility::Static);
+	NewMeshSegment->SetComponentTickEnabled(false);
+	NewMeshSegment->SetGenerateOverlapEvents(false);
+	NewMeshSegment->bComputeFastLocalBounds = true;
+	NewMeshSegment->bComputeBoundsOnceForGame = true;
+	NewMeshSegment->SetCollisionEnabled(ECollisionEnabled::QueryAndProbe);
+
+	++PoolMisses;
+	++ContinuumStats.NumComponentsCreated;
+	INC_DWORD_STAT(STAT_AedificComponentsCreated);
+
+	return NewMeshSegment;
+}
+
+void AAedificSplineContinuum::ReleaseSegments(const int32 Index)
+{
+	for (int32 i = SplineMeshComponents.Num() - 1; i >= Index; --i)
+	{
+		ReleaseSegment(i);
+	}
+
+	if (Index < SplineMeshComponents.Num())
+	{
+		SplineMeshComponents.SetNum(FMath::Max(Index, 0));
+	}
+}
+
+void AAedificSplineContinuum::DestroyPooledComponents()
+{
+	for (USplineMeshComponent* Mesh : PooledSplineMeshComponents)
+	{
+		if (Mesh->IsValidLowLevelFast())
+		{
+			Mesh->DestroyComponent();
+
+			++ContinuumStats.NumComponentsDestroyed;
+			INC_DWORD_STAT(STAT_AedificComponentsDestroyed);
+		}
+	}
+
+	PooledSplineMeshComponents.Reset();
+}
+
+void AAedificSplineContinuum::ReleaseSegment(const int32 Index)
+{
+	USplineMeshComponent* MeshSegment = SplineMeshComponents[Index];
+	if (IsValid(MeshSegment) && !MeshSegment->IsBeingDestroyed())
+	{
+		// Keep the component registered but hidden, so re-using it doesn't require a new render state.
+		MeshSegment->SetVisibility(false);
+		MeshSegment->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		PooledSplineMeshComponents.Add(MeshSegment);
+	}
+
+	SplineMeshComponents[Index] = nullptr;
+}
+
+void AAedificSplineContinuum::AcquireSegmentComponent(const int32 Index)
+{
+	if (Index >= SplineMeshComponents.Num())
+	{
+		SplineMeshComponents.SetNum(Index + 1);
+	}
+
+	USplineMeshComponent* MeshSegment = AcquireSplineMeshComponent(MeshSegments[Index]);
+	SplineMeshComponents[Index] = MeshSegment;
+
+	ApplySegment(MeshSegment, MeshSegments[Index]);
+}
+
+void AAedificSplineContinuum::TrimPool(const int32 MaxPooled)
+{
+	while (PooledSplineMeshComponents.Num() > FMath::Max(MaxPooled, 0))
+	{
+		USplineMeshComponent* Mesh = PooledSplineMeshComponents.Pop(EAllowShrinking::No);
+		if (Mesh->IsValidLowLevelFast())
+		{
+			Mesh->DestroyComponent();
+
+			++ContinuumStats.NumComponentsDestroyed;
+			INC_DWORD_STAT(STAT_AedificComponentsDestroyed);
+		}
+	}
+}
+
+int32 AAedificSplineContinuum::GetNumMaterializedSegments() const
+{
+	int32 NumMaterialized = 0;
+	for (const USplineMeshComponent* MeshSegment : SplineMeshComponents)
+	{
+		NumMaterialized += IsValid(MeshSegment) ? 1 : 0;
+	}
+
+	return NumMaterialized;
+}
+
+void AAedificSplineContinuum::UpdateVirtualization(TConstArrayView<FVector> Sources, const double EndTime)
+{
+	if (!bVirtualizationActive || OutputMode != EAedificMeshOutput::SplineMeshes)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::UpdateVirtualization);
+	SCOPE_CYCLE_COUNTER(STAT_AedificUpdateVirtualization);
+
+	bVirtualizationRequested = false;
+
+	const TSharedPtr<const FAedificSegmentIndex> Index = GetSegmentIndex();
+	if (!Index.IsValid() || Index->GetNumSegments() != MeshSegments.Num())
+	{
+		return;
+	}
+
+	const int32 NumSegments = MeshSegments.Num();
+	TArray<int32> InRange;
+	TArray<int32> Offsets;
+
+	// Components are kept up to the outer radius, released ones go back to the pool before new ones are acquired from it.
+	TBitArray<> KeptSegments(false, NumSegments);
+	Index->FindSegmentsInRadius(Sources, VirtualizationRadius + FMath::Max(VirtualizationHysteresis, 0.f), InRange, Offsets);
+
+	for (const int32 SegmentIndex : InRange)
+	{
+		KeptSegments[SegmentIndex] = true;
+	}
+
+	for (int32 i = 0; i < SplineMeshComponents.Num(); ++i)
+	{
+		if (SplineMeshComponents[i] && (i >= NumSegments || !KeptSegments[i]))
+		{
+			ReleaseSegment(i);
+		}
+	}
+
+	// Only segments within the inner radius get a new one.
+	InRange.Reset();
+	Offsets.Reset();
+	Index->FindSegmentsInRadius(Sources, VirtualizationRadius, InRange, Offsets);
+
+	int32 NumAcquired = 0;
+	for (const int32 SegmentIndex : InRange)
+	{
+		if (SplineMeshComponents.IsValidIndex(SegmentIndex) && IsValid(SplineMeshComponents[SegmentIndex]))
+		{
+			continue;
+		}
+
+		// Several sources may find the same segment, and at least one component is acquired per update.
+		if (NumAcquired > 0 && EndTime > 0.0 && FPlatformTime::Seconds() >= EndTime)
+		{
+			bVirtualizationRequested = true;
+			break;
+		}
+
+		AcquireSegmentComponent(SegmentIndex);
+		++NumAcquired;
+	}
+
+	// The pool only has to absorb the segments moving in and out of range.
+	TrimPool(CVarAedificVirtualizationPoolSize.GetValueOnGameThread());
+}
+
+void AAedificSplineContinuum::EmptyMesh()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::EmptyMesh);
+	SCOPE_CYCLE_COUNTER(STAT_AedificEmptyMesh);
+
+	CancelPendingBuild();
+
+	// A rebuild still queued reports its latency once it finishes, otherwise the request is abandoned.
+	if (!bRebuildRequested)
+	{
+		if (UAedificRebuildSubsystem* RebuildSubsystem = GetRebuildSubsystem())
+		{
+			RebuildSubsystem->NotifyRebuildCancelled(this);
+		}
+	}
+
+	ReleaseSegments(0);
+	DestroyPooledComponents();
+	EmptyBakedMesh();
+	EmptyInstancedMesh();
+	EmptyScatteredMesh();
+	EmptyDynamicMesh();
+
+	MeshSegments.Reset();
+	BuildState.Reset();
+
+	PoolHits = 0;
+	PoolMisses = 0;
+}
+
+void AAedificSplineContinuum::BakeMesh()
+{
+#if WITH_EDITOR
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::BakeMesh);
+	SCOPE_CYCLE_COUNTER(STAT_AedificBakeMesh);
+
+	if (!StaticMesh || MeshSegments.Num() == 0)
+	{
+		return;
+	}
+
+	const TArray<FIntPoint> Chunks = ComputeBakeChunks();
+	const int32 NumChunks = Chunks.Num();
+
+	// Nothing to bake if the segments didn't change and the baked meshes are still around.
+	if (!bBakeRequired && AreBakedChunksValid(Chunks))
+	{
+		return;
+	}
+
+	// Re-baking over unloaded chunks would duplicate them.
+	if (bBakeStreamingChunks && StreamingChunks.ContainsByPredicate([](const TSoftObjectPtr<AAedificContinuumChunk>& ChunkActor) { return ChunkActor.IsPending(); }))
+	{
+		UE_LOG(LogAedific, Warning, TEXT("%s: Some streaming chunks aren't loaded, load the whole continuum before baking it."), *GetName());
+		return;
+	}
+
+	const bool bClosedLoop = SplineComponent->IsClosedLoop();
+
+	for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+	{
+		const int32 FirstSegment = Chunks[Chunk].X;
+		const int32 NumSegments = Chunks[Chunk].Y;
+
+		// Weld the first seam to the previous chunk, or to the end of the spline on closed loops.
+		const FAedificMeshSegment* PreviousSegment = (FirstSegment > 0) ? &MeshSegments[FirstSegment - 1] : (bClosedLoop ? &MeshSegments.Last() : nullptr);
+
+		// Streaming chunks hold their baked mesh, so it streams along with them.
+		AAedificContinuumChunk* ChunkActor = bBakeStreamingChunks ? GetStreamingChunk(Chunk) : nullptr;
+		if (bBakeStreamingChunks && !ChunkActor)
+		{
+			continue;
+		}
+
+		// Baked meshes either live within the level, outered to their Actor, or as assets in the chosen folder.
+		const FString MeshName = FString::Printf(TEXT("SM_%s_Baked%d"), *GetName(), Chunk);
+		UPackage* Package = nullptr;
+		UObject* Outer = ChunkActor ? (UObject*)ChunkActor : (UObject*)this;
+		if (!BakedMeshDirectory.Path.IsEmpty())
+		{
+			Package = CreatePackage(*FPaths::Combine(BakedMeshDirectory.Path, MeshName));
+			Package->FullyLoad();
+			Outer = Package;
+		}
+
+		UStaticMesh* BakedMesh = FindObject<UStaticMesh>(Outer, *MeshName);
+		const bool bNewMesh = (BakedMesh == nullptr);
+		if (bNewMesh)
+		{
+			BakedMesh = NewObject<UStaticMesh>(Outer, *MeshName, Package ? (RF_Public | RF_Standalone | RF_Transactional) : RF_Transactional);
+		}
+
+		if (!FAedificMeshBaker::BakeSegments(StaticMesh, MakeArrayView(MeshSegments).Slice(FirstSegment, NumSegments), PreviousSegment, BakedMesh))
+		{
+			UE_LOG(LogAedific, Warning, TEXT("%s: Failed to bake segments %d to %d."), *GetName(), FirstSegment, FirstSegment + NumSegments - 1);
+			continue;
+		}
+
+		if (Package)
+		{
+			if (bNewMesh)
+			{
+				FAssetRegistryModule::AssetCreated(BakedMesh);
+			}
+
+			Package->MarkPackageDirty();
+		}
+
+		// Re-use the chunk's component if it's still around.
+		UStaticMeshComponent* BakedComponent = ChunkActor ? ChunkActor->GetMeshComponent() : (BakedMeshComponents.IsValidIndex(Chunk) ? BakedMeshComponents[Chunk].Get() : nullptr);
+		if (!IsValid(BakedComponent))
+		{
+			BakedComponent = NewObject<UStaticMeshComponent>(this, UStaticMeshComponent::StaticClass(),
+				MakeUniqueObjectName(this, UStaticMeshComponent::StaticClass(), TEXT("BakedMesh")), EObjectFlags::RF_Transactional);
+			BakedComponent->CreationMethod = EComponentCreationMethod::Instance;
+			BakedComponent->RegisterComponent();
+			BakedComponent->AttachToComponent(RootComponent, FAttachmentTransformRules::FAttachmentTransformRules(EAttachmentRule::KeepRelative, true));
+
+			BakedComponent->SetMobility(EComponentMobility::Static);
+			BakedComponent->SetComponentTickEnabled(false);
+			BakedComponent->SetGenerateOverlapEvents(false);
+			BakedComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndProbe);
+
+			if (Chunk >= BakedMeshComponents.Num())
+			{
+				BakedMeshComponents.SetNum(Chunk + 1);
+			}
+
+			BakedMeshComponents[Chunk] = BakedComponent;
+		}
+
+		if (ChunkActor)
+		{
+			ChunkActor->SetSegmentRange(FirstSegment, NumSegments);
+		}
+
+		BakedComponent->SetStaticMesh(BakedMesh);
+		BakedComponent->MarkRenderStateDirty();
+		BakedComponent->RecreatePhysicsState();
+
+		if (MaterialOverride)
+		{
+			BakedComponent->SetMaterial(0, MaterialOverride);
+		}
+	}
+
+	// Remove chunks left over from a longer previous bake, or from the other chunking mode.
+	const int32 NumBakedComponents = bBakeStreamingChunks ? 0 : NumChunks;
+	for (int32 Chunk = BakedMeshComponents.Num() - 1; Chunk >= NumBakedComponents; --Chunk)
+	{
+		if (IsValid(BakedMeshComponents[Chunk]))
+		{
+			BakedMeshComponents[Chunk]->DestroyComponent();
+		}
+	}
+
+	BakedMeshComponents.SetNum(FMath::Min(BakedMeshComponents.Num(), NumBakedComponents));
+	TruncateStreamingChunks(bBakeStreamingChunks ? NumChunks : 0);
+
+	// The baked meshes replace the spline mesh components entirely.
+	ReleaseSegments(0);
+	DestroyPooledComponents();
+
+	bBakeRequired = false;
+#endif // WITH_EDITOR
+}
+
+#if WITH_EDITOR
+TArray<FIntPoint> AAedificSplineContinuum::ComputeBakeChunks() const
+{
+	TArray<FIntPoint> Chunks;
+
+	const int32 ChunkSize = FMath::Max(BakeChunkSize, 1);
+	const double CellSize = FMath::Max(StreamingCellSize, 100.f);
+	const FTransform& Transform = GetActorTransform();
+
+	FIntPoint ChunkCell = FIntPoint::ZeroValue;
+	for (int32 i = 0; i < MeshSegments.Num(); ++i)
+	{
+		// Segments belong to the grid cell holding their middle, in world space.
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		if (bBakeStreamingChunks)
+		{
+			const FVector Center = Transform.TransformPosition((MeshSegments[i].StartLocation + MeshSegments[i].EndLocation) * 0.5);
+			Cell = FIntPoint(FMath::FloorToInt32(Center.X / CellSize), FMath::FloorToInt32(Center.Y / CellSize));
+		}
+
+		if (Chunks.Num() == 0 || Cell != ChunkCell || Chunks.Last().Y >= ChunkSize)
+		{
+			Chunks.Emplace(i, 0);
+			ChunkCell = Cell;
+		}
+
+		++Chunks.Last().Y;
+	}
+
+	return Chunks;
+}
+
+bool AAedificSplineContinuum::AreBakedChunksValid(TConstArrayView<FIntPoint> Chunks) const
+{
+	if (!bBakeStreamingChunks)
+	{
+		return StreamingChunks.Num() == 0 && BakedMeshComponents.Num() == Chunks.Num()
+			&& !BakedMeshComponents.ContainsByPredicate([](const UStaticMeshComponent* Component) { return !IsValid(Component); });
+	}
+
+	if (BakedMeshComponents.Num() > 0 || StreamingChunks.Num() != Chunks.Num())
+	{
+		return false;
+	}
+
+	// Chunks follow the continuum, a moved continuum must move and possibly re-split them.
+	for (int32 Chunk = 0; Chunk < Chunks.Num(); ++Chunk)
+	{
+		const AAedificContinuumChunk* ChunkActor = StreamingChunks[Chunk].Get();
+		if (!IsValid(ChunkActor) || !ChunkActor->HasSegmentRange(Chunks[Chunk].X, Chunks[Chunk].Y) || !ChunkActor->GetActorTransform().Equals(GetActorTransform()))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+AAedificContinuumChunk* AAedificSplineContinuum::GetStreamingChunk(const int32 Chunk)
+{
+	if (Chunk >= StreamingChunks.Num())
+	{
+		StreamingChunks.SetNum(Chunk + 1);
+	}
+
+	AAedificContinuumChunk* ChunkActor = StreamingChunks[Chunk].Get();
+	if (IsValid(ChunkActor))
+	{
+		ChunkActor->SetActorTransform(GetActorTransform());
+		return ChunkActor;
+	}
+
+	// Not attached to this Actor, as World Partition would then stream them together.
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.Name = *FString::Printf(TEXT("%s_Chunk%d"), *GetName(), Chunk);
+	SpawnParameters.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+	SpawnParameters.OverrideLevel = GetLevel();
+	SpawnParameters.ObjectFlags = RF_Transactional;
+
+	ChunkActor = GetWorld()->SpawnActor<AAedificContinuumChunk>(AAedificContinuumChunk::StaticClass(), GetActorTransform(), SpawnParameters);
+	if (!ChunkActor)
+	{
+		UE_LOG(LogAedific, Warning, TEXT("%s: Failed to spawn streaming chunk %d."), *GetName(), Chunk);
+		return nullptr;
+	}
+
+	ChunkActor->SetActorLabel(FString::Printf(TEXT("%s_Chunk%d"), *GetActorLabel(), Chunk));
+	ChunkActor->SetFolderPath(GetFolderPath());
+
+	StreamingChunks[Chunk] = ChunkActor;
+	return ChunkActor;
+}
+
+void AAedificSplineContinuum::TruncateStreamingChunks(const int32 NumChunks)
+{
+	for (int32 Chunk = StreamingChunks.Num() - 1; Chunk >= NumChunks; --Chunk)
+	{
+		if (AAedificContinuumChunk* ChunkActor = StreamingChunks[Chunk].Get(); IsValid(ChunkActor))
+		{
+			ChunkActor->Destroy();
+		}
+	}
+
+	StreamingChunks.SetNum(FMath::Min(StreamingChunks.Num(), NumChunks));
+}
+#endif // WITH_EDITOR
+
+void AAedificSplineContinuum::EmptyBakedMesh()
+{
+	for (UStaticMeshComponent* BakedComponent : BakedMeshComponents)
+	{
+		if (BakedComponent->IsValidLowLevelFast())
+		{
+			BakedComponent->DestroyComponent();
+		}
+	}
+
+	BakedMeshComponents.Reset();
+}
+
+UAedificInstancedSplineMeshComponent* AAedificSplineContinuum::GetInstancedMeshComponent()
+{
+	if (!IsValid(InstancedMeshComponent) || InstancedMeshComponent->IsBeingDestroyed())
+	{
+		// Created as an instance component so re-running the construction script doesn't destroy it.
+		InstancedMeshComponent = NewObject<UAedificInstancedSplineMeshComponent>(this, UAedificInstancedSplineMeshComponent::StaticClass(),
+			MakeUniqueObjectName(this, UAedificInstancedSplineMeshComponent::StaticClass(), TEXT("InstancedSplineMesh")), EObjectFlags::RF_Transactional);
+		InstancedMeshComponent->CreationMethod = EComponentCreationMethod::Instance;
+		InstancedMeshComponent->RegisterComponent();
+		InstancedMeshComponent->AttachToComponent(RootComponent, FAttachmentTransformRules::FAttachmentTransformRules(EAttachmentRule::KeepRelative, true));
+	}
+
+	if (InstancedMeshComponent->GetStaticMesh() != StaticMesh)
+	{
+		// Records are packed against the mesh bounds, so they must all be packed again.
+		InstancedMeshComponent->ClearInstances();
+		InstancedMeshComponent->SetStaticMesh(StaticMesh);
+	}
+
+	if (MaterialOverride)
+	{
+		InstancedMeshComponent->SetMaterial(0, MaterialOverride);
+	}
+
+	return InstancedMeshComponent;
+}
+
+void AAedificSplineContinuum::UpdateInstancedMesh(const int32 LoopSize)
+{
+	if (!IsValid(InstancedMeshComponent))
+	{
+		return;
+	}
+
+	InstancedMeshComponent->TruncateSegments(LoopSize);
+	InstancedMeshComponent->MarkRenderStateDirty();
+
+	// The instances replace the spline mesh components entirely.
+	ReleaseSegments(0);
+	DestroyPooledComponents();
+}
+
+void AAedificSplineContinuum::EmptyInstancedMesh()
+{
+	if (InstancedMeshComponent->IsValidLowLevelFast())
+	{
+		InstancedMeshComponent->DestroyComponent();
+	}
+
+	InstancedMeshComponent = nullptr;
+}
+
+UDynamicMeshComponent* AAedificSplineContinuum::GetDynamicMeshComponent(const int32 Chunk)
+{
+	UDynamicMeshComponent* DynamicComponent = DynamicMeshComponents.IsValidIndex(Chunk) ? DynamicMeshComponents[Chunk].Get() : nullptr;
+	if (!IsValid(DynamicComponent) || DynamicComponent->IsBeingDestroyed())
+	{
+		// Created as an instance component so re-running the construction script doesn't destroy it.
+		DynamicComponent = NewObject<UDynamicMeshComponent>(this, UDynamicMeshComponent::StaticClass(),
+			MakeUniqueObjectName(this, UDynamicMeshComponent::StaticClass(), TEXT("DynamicMesh")), EObjectFlags::RF_Transactional);
+		DynamicComponent->CreationMethod = EComponentCreationMethod::Instance;
+		DynamicComponent->SetMobility(EComponentMobility::Movable);
+		DynamicComponent->RegisterComponent();
+		DynamicComponent->AttachToComponent(RootComponent, FAttachmentTransformRules::FAttachmentTransformRules(EAttachmentRule::KeepRelative, true));
+
+		DynamicComponent->SetComponentTickEnabled(false);
+		DynamicComponent->SetGenerateOverlapEvents(false);
+		DynamicComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+		// Collision uses the deformed triangles, cooked on a worker thread whenever the chunk's mesh changes.
+		DynamicComponent->bUseAsyncCooking = true;
+		DynamicComponent->SetComplexAsSimpleCollisionEnabled(true, false);
+
+		// Normals and tangents are deformed along with the vertices, recomputing them would break the welded seams.
+		DynamicComponent->SetTangentsType(EDynamicMeshComponentTangentsMode::ExternallyProvided);
+
+		if (Chunk >= DynamicMeshComponents.Num())
+		{
+			DynamicMeshComponents.SetNum(Chunk + 1);
+		}
+
+		DynamicMeshComponents[Chunk] = DynamicComponent;
+	}
+
+	return DynamicComponent;
+}
+
+void AAedificSplineContinuum::UpdateDynamicMesh()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::UpdateDynamicMesh);
+
+	// The dynamic meshes replace the spline mesh components entirely.
+	ReleaseSegments(0);
+	DestroyPooledComponents();
+
+	const int32 ChunkSize = FMath::Max(DynamicChunkSize, 1);
+	const int32 NumChunks = FMath::DivideAndRoundUp(MeshSegments.Num(), ChunkSize);
+
+	// The render geometry is only read once per mesh, every chunk is rebuilt from a new one or along a new chunk size.
+	if (!DynamicMeshSource.IsValid() || DynamicMeshSourceMesh.Get() != StaticMesh.Get() || DynamicMeshChunkSize != ChunkSize)
+	{
+		DynamicMeshSource = FAedificDynamicMeshBuilder::ExtractSource(StaticMesh);
+		DynamicMeshSourceMesh = StaticMesh.Get();
+		DynamicMeshChunkSize = ChunkSize;
+
+		for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+		{
+			DirtyDynamicChunks.Add(Chunk);
+		}
+	}
+
+	// Remove chunks left over from a longer previous build.
+	for (int32 Chunk = DynamicMeshComponents.Num() - 1; Chunk >= NumChunks; --Chunk)
+	{
+		if (IsValid(DynamicMeshComponents[Chunk]))
+		{
+			DynamicMeshComponents[Chunk]->DestroyComponent();
+		}
+	}
+
+	DynamicMeshComponents.SetNum(FMath::Min(DynamicMeshComponents.Num(), NumChunks));
+
+	if (!DynamicMeshSource.IsValid())
+	{
+		return;
+	}
+
+	// The first segment of a closed loop is welded to the last one.
+	const bool bClosedLoop = SplineComponent->IsClosedLoop();
+	if (bClosedLoop && NumChunks > 1 && DirtyDynamicChunks.Contains(NumChunks - 1))
+	{
+		DirtyDynamicChunks.Add(0);
+	}
+
+	TArray<int32> Chunks;
+	for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+	{
+		// Chunks whose component went missing are rebuilt even if their segments didn't change.
+		if (DirtyDynamicChunks.Contains(Chunk) || !DynamicMeshComponents.IsValidIndex(Chunk) || !IsValid(DynamicMeshComponents[Chunk]))
+		{
+			Chunks.Add(Chunk);
+		}
+	}
+
+	// Chunks past the end of the spline are gone along with their components.
+	DirtyDynamicChunks.Reset();
+	DirtyDynamicChunks.Append(Chunks);
+
+	if (Chunks.Num() == 0)
+	{
+		return;
+	}
+
+	// The build only works on copies of the chunks' segments, the Actor can keep being edited while it runs.
+	TSharedRef<FAedificDynamicMeshBuild> Build = MakeShared<FAedificDynamicMeshBuild>();
+	Build->Generation = ++DynamicMeshGeneration;
+	Build->Source = DynamicMeshSource;
+	Build->Chunks.SetNum(Chunks.Num());
+
+	for (int32 i = 0; i < Chunks.Num(); ++i)
+	{
+		FAedificDynamicMeshChunk& BuildChunk = Build->Chunks[i];
+		BuildChunk.ChunkIndex = Chunks[i];
+
+		const int32 FirstSegment = Chunks[i] * ChunkSize;
+		const int32 NumSegments = FMath::Min(ChunkSize, MeshSegments.Num() - FirstSegment);
+		BuildChunk.Segments.Append(&MeshSegments[FirstSegment], NumSegments);
+
+		if (FirstSegment > 0 || bClosedLoop)
+		{
+			BuildChunk.bHasPreviousSegment = true;
+			BuildChunk.PreviousSegment = MeshSegments[(FirstSegment > 0) ? FirstSegment - 1 : MeshSegments.Num() - 1];
+		}
+	}
+
+	// Commandlets expect the meshes to be up to date as soon as the rebuild runs.
+	if (!CVarAedificAsyncRebuild.GetValueOnGameThread() || IsRunningCommandlet())
+	{
+		FAedificDynamicMeshBuilder::Build(*Build);
+		ApplyDynamicMeshBuild(Build);
+		return;
+	}
+
+	TWeakObjectPtr<AAedificSplineContinuum> WeakThis(this);
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Build]()
+	{
+		FAedificDynamicMeshBuilder::Build(*Build);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Build]()
+		{
+			if (AAedificSplineContinuum* Continuum = WeakThis.Get())
+			{
+				Continuum->ApplyDynamicMeshBuild(Build);
+			}
+		});
+	});
+}
+
+void AAedificSplineContinuum::ApplyDynamicMeshBuild(const TSharedRef<FAedificDynamicMeshBuild>& Build)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::ApplyDynamicMeshBuild);
+
+	// Chunks of a superseded build are still dirty, the newer build rebuilds them from the latest segments.
+	if (Build->Generation != DynamicMeshGeneration || OutputMode != EAedificMeshOutput::Dynamic || !StaticMesh)
+	{
+		UE_LOG(LogAedific, Verbose, TEXT("%s: Discarded a stale dynamic mesh build."), *GetName());
+		return;
+	}
+
+	// Material IDs are the mesh's material slots.
+	TArray<UMaterialInterface*> Materials;
+	for (int32 Slot = 0; Slot < StaticMesh->GetStaticMaterials().Num(); ++Slot)
+	{
+		Materials.Add((Slot == 0 && MaterialOverride) ? MaterialOverride.Get() : StaticMesh->GetMaterial(Slot));
+	}
+
+	for (FAedificDynamicMeshChunk& BuildChunk : Build->Chunks)
+	{
+		UDynamicMeshComponent* DynamicComponent = GetDynamicMeshComponent(BuildChunk.ChunkIndex);
+
+		// Only this chunk's render proxy and collision are rebuilt.
+		DynamicComponent->SetMesh(MoveTemp(BuildChunk.Mesh));
+		DynamicComponent->ConfigureMaterialSet(Materials);
+
+		DirtyDynamicChunks.Remove(BuildChunk.ChunkIndex);
+	}
+}
+
+void AAedificSplineContinuum::EmptyDynamicMesh()
+{
+	for (UDynamicMeshComponent* DynamicComponent : DynamicMeshComponents)
+	{
+		if (DynamicComponent->IsValidLowLevelFast())
+		{
+			DynamicComponent->DestroyComponent();
+		}
+	}
+
+	DynamicMeshComponents.Reset();
+	DirtyDynamicChunks.Reset();
+	DynamicMeshSource.Reset();
+	DynamicMeshSourceMesh.Reset();
+	DynamicMeshChunkSize = 0;
+
+	// Builds still running are discarded once they finish.
+	++DynamicMeshGeneration;
+}
+
+void AAedificSplineContinuum::ScatterMesh(const float MeshLength, const float SplineLength)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::ScatterMesh);
+	SCOPE_CYCLE_COUNTER(STAT_AedificScatterMesh);
+
+	const float Spacing = (ScatterSpacing > KINDA_SMALL_NUMBER) ? ScatterSpacing : MeshLength;
+	const bool bClosedLoop = SplineComponent->IsClosedLoop();
+
+	// Closed loops don't repeat the instance placed at their start on their end.
+	const int32 NumInstances = FMath::Max(1, FMath::FloorToInt(SplineLength / Spacing) + (bClosedLoop ? 0 : 1));
+
+	// Closed loops need an extra frame on their end to close the Parallel Transport loop.
+	const int32 NumFrames = NumInstances + (bClosedLoop ? 1 : 0);
+
+	TArray<float> SampleDistances; SampleDistances.SetNumUninitialized(NumFrames);
+	for (int32 k = 0; k < NumFrames; ++k)
+	{
+		SampleDistances[k] = FMath::Min(k * Spacing, SplineLength);
+	}
+
+	TArray<FAedificSplineSample> Samples; Samples.SetNum(NumFrames);
+	SplineSampler.SampleAtDistances(SampleDistances, Samples);
+
+	TArray<FVector> Positions; Positions.SetNumUninitialized(NumFrames);
+	FAedificVectorStreams Tangents; Tangents.SetNumUninitialized(NumFrames);
+
+	for (int32 k = 0; k < NumFrames; ++k)
+	{
+		Positions[k] = Samples[k].Location;
+		Tangents.Set(k, Samples[k].GetDirection());
+	}
+
+	FAedificVectorStreams Normals;
+	if (bUseParallelTransport && NumFrames > 1)
+	{
+		Normals.SetNumUninitialized(NumFrames);
+		FAedificRotationMinimizingFrames::Propagate(Positions, Tangents, Normals, 0);
+
+		if (bClosedLoop)
+		{
+			FAedificRotationMinimizingFrames::CloseLoop(Tangents, Normals);
+		}
+	}
+
+	TArray<FTransform> InstanceTransforms;
+	InstanceTransforms.Reserve(NumInstances);
+
+	for (int32 k = 0; k < NumInstances; ++k)
+	{
+		// Orientation comes from the same frames the deformed meshes use.
+		const FQuat Rotation = (Normals.Num() > 0) ? FRotationMatrix::MakeFromXZ(Tangents.Get(k), Normals.Get(k)).ToQuat() : Samples[k].Rotation;
+
+		InstanceTransforms.Add(FTransform(Rotation, Positions[k], Samples[k].Scale));
+	}
+
+	// Re-layout in a single bulk update, only re-allocating the instances when their amount changed.
+	UHierarchicalInstancedStaticMeshComponent* ScatteredMesh = GetScatteredMeshComponent();
+	if (ScatteredMesh->GetInstanceCount() == NumInstances)
+	{
+		ScatteredMesh->BatchUpdateInstancesTransforms(0, InstanceTransforms, false, true, true);
+	}
+	else
+	{
+		ScatteredMesh->ClearInstances();
+		ScatteredMesh->AddInstances(InstanceTransforms, false, false);
+	}
+
+	// The instances replace the spline mesh components entirely.
+	ReleaseSegments(0);
+	DestroyPooledComponents();
+	MeshSegments.Reset();
+}
+
+UHierarchicalInstancedStaticMeshComponent* AAedificSplineContinuum::GetScatteredMeshComponent()
+{
+	if (!IsValid(ScatteredMeshComponent) || ScatteredMeshComponent->IsBeingDestroyed())
+	{
+		// Created as an instance component so re-running the construction script doesn't destroy it.
+		ScatteredMeshComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(this, UHierarchicalInstancedStaticMeshComponent::StaticClass(),
+			MakeUniqueObjectName(this, UHierarchicalInstancedStaticMeshComponent::StaticClass(), TEXT("ScatteredMesh")), EObjectFlags::RF_Transactional);
+		ScatteredMeshComponent->CreationMethod = EComponentCreationMethod::Instance;
+		ScatteredMeshComponent->RegisterComponent();
+		ScatteredMeshComponent->AttachToComponent(RootComponent, FAttachmentTransformRules::FAttachmentTransformRules(EAttachmentRule::KeepRelative, true));
+
+		ScatteredMeshComponent->SetMobility(EComponentMobility::Static);
+		ScatteredMeshComponent->SetComponentTickEnabled(false);
+		ScatteredMeshComponent->SetGenerateOverlapEvents(false);
+		ScatteredMeshComponent->SetCollisionEnabled(ECollisionEnabled::QueryAndProbe);
+	}
+
+	if (ScatteredMeshComponent->GetStaticMesh() != StaticMesh)
+	{
+		ScatteredMeshComponent->SetStaticMesh(StaticMesh);
+	}
+
+	if (MaterialOverride)
+	{
+		ScatteredMeshComponent->SetMaterial(0, MaterialOverride);
+	}
+
+	return ScatteredMeshComponent;
+}
+
+void AAedificSplineContinuum::EmptyScatteredMesh()
+{
+	if (ScatteredMeshComponent->IsValidLowLevelFast())
+	{
+		ScatteredMeshComponent->DestroyComponent();
+	}
+
+	ScatteredMeshComponent = nullptr;
+}
+
+void AAedificSplineContinuum::EmptyUnusedOutputs()
+{
+	if (OutputMode != EAedificMeshOutput::Baked)
+	{
+		EmptyBakedMesh();
+#if WITH_EDITOR
+		TruncateStreamingChunks(0);
+#endif // WITH_EDITOR
+	}
+
+	if (OutputMode != EAedificMeshOutput::Instanced)
+	{
+		EmptyInstancedMesh();
+	}
+
+	if (OutputMode != EAedificMeshOutput::Scattered)
+	{
+		EmptyScatteredMesh();
+	}
+
+	if (OutputMode != EAedificMeshOutput::Dynamic)
+	{
+		EmptyDynamicMesh();
+	}
+}
+
+void AAedificSplineContinuum::UpdateMaterial()
+{
+	if (SplineMeshComponents.Num() > 0)
+	{
+		for (USplineMeshComponent* Mesh : SplineMeshComponents)
+		{
+			// Virtualized segments only get their material once they acquire a component.
+			if (!IsValid(Mesh))
+			{
+				continue;
+			}
+
+			if (MaterialOverride)
 			{
 				Mesh->SetMaterial(0, MaterialOverride);
 			}
@@ -539,4 +2316,30 @@ void AAedificSplineContinuum::UpdateMaterial()
 			}
 		}
 	}
+
+	for (UStaticMeshComponent* BakedComponent : BakedMeshComponents)
+	{
+		if (IsValid(BakedComponent))
+		{
+			BakedComponent->SetMaterial(0, MaterialOverride ? MaterialOverride.Get() : BakedComponent->GetStaticMesh()->GetMaterial(0));
+		}
+	}
+
+	if (IsValid(InstancedMeshComponent))
+	{
+		InstancedMeshComponent->SetMaterial(0, MaterialOverride ? MaterialOverride.Get() : StaticMesh->GetMaterial(0));
+	}
+
+	if (IsValid(ScatteredMeshComponent))
+	{
+		ScatteredMeshComponent->SetMaterial(0, MaterialOverride ? MaterialOverride.Get() : StaticMesh->GetMaterial(0));
+	}
+
+	for (UDynamicMeshComponent* DynamicComponent : DynamicMeshComponents)
+	{
+		if (IsValid(DynamicComponent))
+		{
+			DynamicComponent->SetMaterial(0, MaterialOverride ? MaterialOverride.Get() : StaticMesh->GetMaterial(0));
+		}
+	}
 }
@@ -0,0 +1,325 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificSplineFollowers.h"
+#include "Aedific.h"
+#include "AedificSplineContinuum.h"
+
+#include <Algo/BinarySearch.h>
+#include <Components/SplineComponent.h>
+#include <EngineUtils.h>
+#include <HAL/IConsoleManager.h>
+#include <ProfilingDebugging/CpuProfilerTrace.h>
+
+DECLARE_CYCLE_STAT(TEXT("Update Followers"), STAT_AedificUpdateFollowers, STATGROUP_Aedific);
+
+/** Table intervals a cursor steps through before falling back to a binary search. */
+static constexpr int32 MaxCursorSteps = 16;
+
+FAedificFollowerTrack::FAedificFollowerTrack()
+{
+	Transform = FTransform::Identity;
+	bClosedLoop = false;
+	NumSegments = 0;
+}
+
+void FAedificFollowerTrack::Build(TConstArrayView<FAedificMeshSegment> Segments, const FTransform& InTransform, const bool bInClosedLoop)
+{
+	Transform = InTransform;
+	bClosedLoop = bInClosedLoop;
+	NumSegments = Segments.Num();
+
+	StartLocations.SetNumUninitialized(NumSegments);
+	StartTangents.SetNumUninitialized(NumSegments);
+	EndLocations.SetNumUninitialized(NumSegments);
+	EndTangents.SetNumUninitialized(NumSegments);
+	UpVectors.SetNumUninitialized(NumSegments);
+	StartRolls.SetNumUninitialized(NumSegments);
+	EndRolls.SetNumUninitialized(NumSegments);
+	TableDistances.SetNumUninitialized(NumSegments * StepsPerSegment + 1);
+
+	float Distance = 0.f;
+
+	for (int32 i = 0; i < NumSegments; ++i)
+	{
+		const FAedificMeshSegment& Segment = Segments[i];
+
+		StartLocations.Set(i, Segment.StartLocation);
+		StartTangents.Set(i, Segment.StartTangent);
+		EndLocations.Set(i, Segment.EndLocation);
+		EndTangents.Set(i, Segment.EndTangent);
+		UpVectors.Set(i, Segment.UpVector);
+		StartRolls[i] = FMath::DegreesToRadians(Segment.StartRollDegrees);
+		EndRolls[i] = FMath::DegreesToRadians(Segment.EndRollDegrees);
+
+		FVector3f PreviousLocation = FVector3f(Segment.StartLocation);
+
+		for (int32 k = 0; k < StepsPerSegment; ++k)
+		{
+			TableDistances[i * StepsPerSegment + k] = Distance;
+
+			FVector3f Location, Direction, Up;
+			Evaluate(i, (float)(k + 1) / StepsPerSegment, Location, Direction, Up);
+
+			Distance += FVector3f::Dist(PreviousLocation, Location);
+			PreviousLocation = Location;
+		}
+	}
+
+	TableDistances.Last() = Distance;
+}
+
+int32 FAedificFollowerTrack::FindEntry(const float Distance) const
+{
+	if (NumSegments == 0)
+	{
+		return 0;
+	}
+
+	return FMath::Clamp(Algo::UpperBound(TableDistances, Distance) - 1, 0, TableDistances.Num() - 2);
+}
+
+int32 FAedificFollowerTrack::AdvanceEntry(const int32 Entry, const float Distance) const
+{
+	if (NumSegments == 0)
+	{
+		return 0;
+	}
+
+	const int32 LastInterval = TableDistances.Num() - 2;
+	int32 Cursor = FMath::Clamp(Entry, 0, LastInterval);
+
+	for (int32 Step = 0; Step < MaxCursorSteps; ++Step)
+	{
+		if (Cursor < LastInterval && TableDistances[Cursor + 1] <= Distance)
+		{
+			++Cursor;
+		}
+		else if (Cursor > 0 && TableDistances[Cursor] > Distance)
+		{
+			--Cursor;
+		}
+		else
+		{
+			return Cursor;
+		}
+	}
+
+	// Jumps, such as teleports or wrapping around a loop, search the whole table.
+	return FindEntry(Distance);
+}
+
+void FAedificFollowerTrack::GetSegmentAlpha(const int32 Entry, const float Distance, int32& OutSegment, float& OutAlpha) const
+{
+	const float IntervalLength = TableDistances[Entry + 1] - TableDistances[Entry];
+	const float IntervalAlpha = (IntervalLength > UE_SMALL_NUMBER) ? FMath::Clamp((Distance - TableDistances[Entry]) / IntervalLength, 0.f, 1.f) : 0.f;
+
+	OutSegment = Entry / StepsPerSegment;
+	OutAlpha = ((Entry % StepsPerSegment) + IntervalAlpha) / StepsPerSegment;
+}
+
+void FAedificFollowerTrack::Evaluate(const int32 Segment, const float Alpha, FVector3f& OutLocation, FVector3f& OutDirection, FVector3f& OutUp) const
+{
+	const FVector3f P0(StartLocations.X[Segment], StartLocations.Y[Segment], StartLocations.Z[Segment]);
+	const FVector3f T0(StartTangents.X[Segment], StartTangents.Y[Segment], StartTangents.Z[Segment]);
+	const FVector3f P1(EndLocations.X[Segment], EndLocations.Y[Segment], EndLocations.Z[Segment]);
+	const FVector3f T1(EndTangents.X[Segment], EndTangents.Y[Segment], EndTangents.Z[Segment]);
+	const FVector3f SplineUp(UpVectors.X[Segment], UpVectors.Y[Segment], UpVectors.Z[Segment]);
+
+	// Same curve and frame as USplineMeshComponent::CalcSliceTransform(), along the X axis and without smooth interpolation.
+	const float A2 = Alpha * Alpha;
+	const float A3 = A2 * Alpha;
+
+	OutLocation = (2.f * A3 - 3.f * A2 + 1.f) * P0 + (A3 - 2.f * A2 + Alpha) * T0 + (-2.f * A3 + 3.f * A2) * P1 + (A3 - A2) * T1;
+
+	const FVector3f Derivative = (6.f * A2 - 6.f * Alpha) * P0 + (3.f * A2 - 4.f * Alpha + 1.f) * T0 + (-6.f * A2 + 6.f * Alpha) * P1 + (3.f * A2 - 2.f * Alpha) * T1;
+	OutDirection = Derivative.GetSafeNormal();
+
+	const FVector3f BaseX = (SplineUp ^ OutDirection).GetSafeNormal();
+	const FVector3f BaseY = (OutDirection ^ BaseX).GetSafeNormal();
+
+	float Sin, Cos;
+	FMath::SinCos(&Sin, &Cos, FMath::Lerp(StartRolls[Segment], EndRolls[Segment], Alpha));
+
+	OutUp = Cos * BaseY + Sin * BaseX;
+}
+
+FAedificSplineFollowers::FAedificSplineFollowers()
+{
+	bTrackChanged = true;
+}
+
+void FAedificSplineFollowers::SetTrack(const TSharedPtr<const FAedificFollowerTrack>& InTrack)
+{
+	if (Track != InTrack)
+	{
+		Track = InTrack;
+		bTrackChanged = true;
+	}
+}
+
+int32 FAedificSplineFollowers::Add(const float Distance, const float Speed)
+{
+	Speeds.Add(Speed);
+	Entries.Add(Track.IsValid() ? Track->FindEntry(Distance) : 0);
+	Segments.Add(0);
+	Alphas.Add(0.f);
+	Locations.Add(FVector::ZeroVector);
+	Rotations.Add(FQuat::Identity);
+
+	return Distances.Add(Distance);
+}
+
+void FAedificSplineFollowers::RemoveAtSwap(const int32 Index)
+{
+	Distances.RemoveAtSwap(Index);
+	Speeds.RemoveAtSwap(Index);
+	Entries.RemoveAtSwap(Index);
+	Segments.RemoveAtSwap(Index);
+	Alphas.RemoveAtSwap(Index);
+	Locations.RemoveAtSwap(Index);
+	Rotations.RemoveAtSwap(Index);
+}
+
+void FAedificSplineFollowers::Update(const float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(Aedific::UpdateFollowers);
+	SCOPE_CYCLE_COUNTER(STAT_AedificUpdateFollowers);
+
+	const int32 NumFollowers = Distances.Num();
+
+	if (!Track.IsValid() || !Track->IsValid() || NumFollowers == 0)
+	{
+		return;
+	}
+
+	const FAedificFollowerTrack& FollowerTrack = *Track;
+	const float Length = FollowerTrack.GetLength();
+	const bool bClosedLoop = FollowerTrack.IsClosedLoop() && Length > UE_SMALL_NUMBER;
+
+	// Move the distances.
+	for (int32 i = 0; i < NumFollowers; ++i)
+	{
+		const float Distance = Distances[i] + Speeds[i] * DeltaTime;
+		Distances[i] = bClosedLoop ? Distance - FMath::FloorToFloat(Distance / Length) * Length : FMath::Clamp(Distance, 0.f, Length);
+	}
+
+	// Move the cursors, from scratch if they belong to another track.
+	if (bTrackChanged)
+	{
+		for (int32 i = 0; i < NumFollowers; ++i)
+		{
+			Entries[i] = FollowerTrack.FindEntry(Distances[i]);
+		}
+
+		bTrackChanged = false;
+	}
+	else
+	{
+		for (int32 i = 0; i < NumFollowers; ++i)
+		{
+			Entries[i] = FollowerTrack.AdvanceEntry(Entries[i], Distances[i]);
+		}
+	}
+
+	for (int32 i = 0; i < NumFollowers; ++i)
+	{
+		FollowerTrack.GetSegmentAlpha(Entries[i], Distances[i], Segments[i], Alphas[i]);
+	}
+
+	// Evaluate the curves.
+	LocalLocations.SetNumUninitialized(NumFollowers);
+	LocalDirections.SetNumUninitialized(NumFollowers);
+	LocalUps.SetNumUninitialized(NumFollowers);
+
+	for (int32 i = 0; i < NumFollowers; ++i)
+	{
+		FVector3f Location, Direction, Up;
+		FollowerTrack.Evaluate(Segments[i], Alphas[i], Location, Direction, Up);
+
+		LocalLocations.Set(i, FVector(Location));
+		LocalDirections.Set(i, FVector(Direction));
+		LocalUps.Set(i, FVector(Up));
+	}
+
+	// Build the frames, in world space.
+	const FTransform& Transform = FollowerTrack.GetTransform();
+	const FQuat TransformRotation = Transform.GetRotation();
+
+	for (int32 i = 0; i < NumFollowers; ++i)
+	{
+		Locations[i] = Transform.TransformPosition(LocalLocations.Get(i));
+		Rotations[i] = TransformRotation * FRotationMatrix::MakeFromXZ(LocalDirections.Get(i), LocalUps.Get(i)).ToQuat();
+	}
+}
+
+UE::Tasks::FTask FAedificSplineFollowers::UpdateAsync(const float DeltaTime)
+{
+	return UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, DeltaTime]()
+	{
+		Update(DeltaTime);
+	});
+}
+
+static void BenchmarkFollowers(const TArray<FString>& Args, UWorld* World)
+{
+	const int32 NumFollowers = FMath::Max((Args.Num() > 0) ? FCString::Atoi(*Args[0]) : 1000, 1);
+	constexpr int32 NumTicks = 60;
+	constexpr float DeltaTime = 1.f / 60.f;
+
+	for (TActorIterator<AAedificSplineContinuum> It(World); It; ++It)
+	{
+		const USplineComponent* Spline = It->GetSplineComponent();
+		const TSharedPtr<const FAedificFollowerTrack> Track = It->GetFollowerTrack();
+		if (!Spline || !Track.IsValid() || !Track->IsValid())
+		{
+			continue;
+		}
+
+		const float Length = Track->GetLength();
+
+		// Agents spread along the continuum, driving at 10 to 30 m/s.
+		FAedificSplineFollowers Followers;
+		Followers.SetTrack(Track);
+
+		FRandomStream Random(NumFollowers);
+		for (int32 i = 0; i < NumFollowers; ++i)
+		{
+			Followers.Add(Random.FRandRange(0.f, Length), Random.FRandRange(1000.f, 3000.f));
+		}
+
+		TArray<float> StartDistances;
+		for (int32 i = 0; i < NumFollowers; ++i)
+		{
+			StartDistances.Add(Followers.GetDistance(i));
+		}
+
+		// Per-call path, each agent querying the spline component every tick.
+		const double PerCallStart = FPlatformTime::Seconds();
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			for (int32 i = 0; i < NumFollowers; ++i)
+			{
+				const float Distance = FMath::Clamp(StartDistances[i] + Followers.GetSpeed(i) * DeltaTime * Tick, 0.f, Length);
+				Spline->GetLocationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+				Spline->GetRotationAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World);
+			}
+		}
+		const double PerCallTime = (FPlatformTime::Seconds() - PerCallStart) / NumTicks;
+
+		// Cursors.
+		const double FollowersStart = FPlatformTime::Seconds();
+		for (int32 Tick = 0; Tick < NumTicks; ++Tick)
+		{
+			Followers.Update(DeltaTime);
+		}
+		const double FollowersTime = (FPlatformTime::Seconds() - FollowersStart) / NumTicks;
+
+		UE_LOG(LogAedific, Display, TEXT("%s: %d followers, per-call %.3f ms per tick, cursors %.3f ms per tick."),
+			*It->GetName(), NumFollowers, PerCallTime * 1000.0, FollowersTime * 1000.0);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkFollowersCommand(
+	TEXT("Aedific.BenchmarkFollowers"),
+	TEXT("Compares batched follower cursors against per-call spline component queries on every continuum. Optional argument: amount of followers (default 1000)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchmarkFollowers));
@@ -0,0 +1,188 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificSplineMath.h"
+#include "Aedific.h"
+#include "AedificRotationMinimizingFrames.h"
+
+#include <HAL/IConsoleManager.h>
+
+void FAedificSplineMath::ComputeTangents(TConstArrayView<FVector> Locations, const bool bClosed, const float Scale, TArrayView<FVector> OutArriveTangents, TArrayView<FVector> OutLeaveTangents)
+{
+	const int32 NumPoints = Locations.Num();
+	check(OutArriveTangents.Num() == NumPoints && OutLeaveTangents.Num() == NumPoints);
+
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		const FVector& CurrentPoint = Locations[i];
+		FVector PreviousPoint, NextPoint;
+
+		// Determine neighboring points based on loop type and position.
+		if (bClosed)
+		{
+			PreviousPoint = Locations[(i == 0) ? NumPoints - 1 : i - 1];
+			NextPoint = Locations[(i == NumPoints - 1) ? 0 : i + 1];
+		}
+		else
+		{
+			PreviousPoint = (i > 0) ? Locations[i - 1] : CurrentPoint;
+			NextPoint = (i < NumPoints - 1) ? Locations[i + 1] : CurrentPoint;
+		}
+
+		FVector Incoming = FVector::ZeroVector;
+		FVector Outgoing = FVector::ZeroVector;
+
+		// Calculate tangent vectors.
+		if ((i > 0 && i < NumPoints - 1) || bClosed)
+		{
+			// Interior point or closed spline become unified direction (Catmull-Rom style).
+			const FVector UnifiedDir = (NextPoint - PreviousPoint).GetSafeNormal();
+
+			Incoming = UnifiedDir * (CurrentPoint - PreviousPoint).Size() * Scale;
+			Outgoing = UnifiedDir * (NextPoint - CurrentPoint).Size() * Scale;
+		}
+		else
+		{
+			// Endpoints of an open spline become one-sided tangents.
+			if (i > 0)
+			{
+				Incoming = (CurrentPoint - PreviousPoint) * Scale;
+			}
+			if (i < NumPoints - 1)
+			{
+				Outgoing = (NextPoint - CurrentPoint) * Scale;
+			}
+		}
+
+		OutArriveTangents[i] = Incoming;
+		OutLeaveTangents[i] = Outgoing;
+	}
+}
+
+float FAedificSplineMath::GetRelativeRoll(const FQuat& Rotation, const FVector& Direction, const FVector& Right, const FVector& Up)
+{
+	const FVector ForwardVector = Rotation.UnrotateVector(Direction).GetSafeNormal();
+	const FVector RightVector = Rotation.UnrotateVector(Right).GetSafeNormal();
+	const FVector UpVector = Rotation.UnrotateVector(Up).GetSafeNormal();
+
+	FMatrix Matrix(ForwardVector, RightVector, UpVector, FVector::ZeroVector);
+
+	return Matrix.Rotator().Roll;
+}
+
+float FAedificSplineMath::CalculateRollInDegrees(const FVector& Tangent, const FVector& Normal, const FVector& ReferenceUp)
+{
+	// Project the ReferenceUp onto the plane perpendicular to the tangent.
+	// This gives us the spline mesh's default, non-rolled "up" direction.
+	const FVector DefaultUp = (ReferenceUp - Tangent * FVector::DotProduct(ReferenceUp, Tangent)).GetSafeNormal();
+
+	// Create an orthonormal basis on that plane with a "right" vector (binormal).
+	const FVector Binormal = FVector::CrossProduct(Tangent, DefaultUp);
+
+	// Calculate the angle between the DefaultUp and our desired Normal on that plane.
+	// We get the cosine of the angle from the dot product.
+	const float CosAngle = FVector::DotProduct(DefaultUp, Normal);
+
+	// We get the sine of the angle by projecting the Normal onto the Binormal.
+	const float SinAngle = FVector::DotProduct(Binormal, Normal);
+
+	// Use Atan2 to find the angle in radians and convert to degrees.
+	return -FMath::RadiansToDegrees(FMath::Atan2(SinAngle, CosAngle));
+}
+
+float FAedificSplineMath::GetTwistDegrees(const FVector& StartDirection, const FVector& StartUp, const FVector& EndDirection, const FVector& EndUp)
+{
+	const FVector AlignedUp = FQuat::FindBetweenNormals(StartDirection, EndDirection).RotateVector(StartUp);
+	return FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(AlignedUp, EndUp), -1.0, 1.0)));
+}
+
+void FAedificSplineMath::ComputeFrameSegmentRolls(const FVector& StartTangent, const FVector& StartNormal, const FVector& EndTangent, const FVector& EndNormal,
+	FVector& OutUpVector, float& OutStartRollDegrees, float& OutEndRollDegrees)
+{
+	// The single "UpVector" for SetSplineUpDir acts as a reference frame.
+	// Averaging the start and end normals is a reasonable choice for this reference.
+	OutUpVector = (StartNormal + EndNormal).GetSafeNormal();
+
+	OutStartRollDegrees = CalculateRollInDegrees(StartTangent, StartNormal, OutUpVector);
+	OutEndRollDegrees = CalculateRollInDegrees(EndTangent, EndNormal, OutUpVector);
+}
+
+/** Points along a helix with a varying radius, curving and climbing all along. */
+static void MakeBenchmarkPoints(const int32 NumPoints, TArray<FVector>& OutPoints)
+{
+	OutPoints.SetNumUninitialized(NumPoints);
+
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		const float T = 0.05f * (float)i;
+		const float Radius = 2000.f + 500.f * FMath::Sin(0.1f * T);
+
+		OutPoints[i] = FVector(Radius * FMath::Cos(T), Radius * FMath::Sin(T), 20.f * (float)i);
+	}
+}
+
+static void BenchmarkSplineMath(const TArray<FString>& Args)
+{
+	static const int32 Sizes[] = { 100, 1000, 10000, 100000 };
+
+	// Repeat the small sizes, so every measure covers about the same amount of work.
+	constexpr int32 WorkPerMeasure = 1000000;
+
+	for (const int32 Size : Sizes)
+	{
+		const int32 NumRepeats = FMath::Max(1, WorkPerMeasure / Size);
+
+		TArray<FVector> Points;
+		MakeBenchmarkPoints(Size, Points);
+
+		// Tangents.
+		TArray<FVector> ArriveTangents; ArriveTangents.SetNumUninitialized(Size);
+		TArray<FVector> LeaveTangents; LeaveTangents.SetNumUninitialized(Size);
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Repeat = 0; Repeat < NumRepeats; ++Repeat)
+		{
+			FAedificSplineMath::ComputeTangents(Points, false, 1.f, ArriveTangents, LeaveTangents);
+		}
+		const double TangentTime = (FPlatformTime::Seconds() - StartTime) / NumRepeats;
+
+		// Rotation-minimizing frames, one per point.
+		FAedificVectorStreams Tangents; Tangents.SetNumUninitialized(Size);
+		FAedificVectorStreams Normals; Normals.SetNumUninitialized(Size);
+
+		for (int32 i = 0; i < Size; ++i)
+		{
+			Tangents.Set(i, (LeaveTangents[i] + ArriveTangents[i]).GetSafeNormal());
+		}
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Repeat = 0; Repeat < NumRepeats; ++Repeat)
+		{
+			FAedificRotationMinimizingFrames::Propagate(Points, Tangents, Normals, 0);
+		}
+		const double FrameTime = (FPlatformTime::Seconds() - StartTime) / NumRepeats;
+
+		// Segments between consecutive frames.
+		double Checksum = 0.0;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Repeat = 0; Repeat < NumRepeats; ++Repeat)
+		{
+			for (int32 i = 0; i < Size - 1; ++i)
+			{
+				FVector UpVector;
+				float StartRoll, EndRoll;
+				FAedificSplineMath::ComputeFrameSegmentRolls(Tangents.Get(i), Normals.Get(i), Tangents.Get(i + 1), Normals.Get(i + 1), UpVector, StartRoll, EndRoll);
+				Checksum += StartRoll - EndRoll;
+			}
+		}
+		const double SegmentTime = (FPlatformTime::Seconds() - StartTime) / NumRepeats;
+
+		UE_LOG(LogAedific, Display, TEXT("%6d points: tangents %.1f ns/point, frames %.1f ns/frame, segments %.1f ns/segment (checksum %.3f)."),
+			Size, TangentTime * 1e9 / Size, FrameTime * 1e9 / Size, SegmentTime * 1e9 / FMath::Max(Size - 1, 1), Checksum);
+	}
+}
+
+static FAutoConsoleCommand BenchmarkSplineMathCommand(
+	TEXT("Aedific.BenchmarkMath"),
+	TEXT("Measures tangents, frames and segment rolls at 100 to 100k points, the results are checked by the Aedific.Math automation tests. Runs headless with -nullrhi -ExecCmds."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkSplineMath));
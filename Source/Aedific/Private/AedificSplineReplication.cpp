@@ -0,0 +1,159 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificSplineReplication.h"
+#include "AedificSplineContinuum.h"
+
+#include <Components/SplineComponent.h>
+#include <Engine/NetSerialization.h>
+#include <Serialization/BitReader.h>
+#include <Serialization/BitWriter.h>
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AedificSplineReplication)
+
+FAedificSplinePointEdit::FAedificSplinePointEdit()
+{
+	PointIndex =	INDEX_NONE;
+	Sequence =		0;
+	Location =		FVector::ZeroVector;
+	ArriveTangent =	FVector::ZeroVector;
+	LeaveTangent =	FVector::ZeroVector;
+	Rotation =		FRotator::ZeroRotator;
+	Scale =			FVector::OneVector;
+	PointType =		(uint8)ESplinePointType::Curve;
+	bHasTangents =	false;
+}
+
+void FAedificSplinePointEdit::Capture(const USplineComponent* Spline, const int32 Index, const bool bWithTangents)
+{
+	PointIndex = Index;
+	Location = Spline->GetLocationAtSplinePoint(Index, ESplineCoordinateSpace::Local);
+	ArriveTangent = Spline->GetArriveTangentAtSplinePoint(Index, ESplineCoordinateSpace::Local);
+	LeaveTangent = Spline->GetLeaveTangentAtSplinePoint(Index, ESplineCoordinateSpace::Local);
+	Rotation = Spline->GetRotationAtSplinePoint(Index, ESplineCoordinateSpace::Local);
+	Scale = Spline->GetScaleAtSplinePoint(Index);
+	PointType = (uint8)Spline->GetSplinePointType(Index);
+
+	// Tangents of the other point types are computed by UpdateSpline, they're only replicated for custom tangent points.
+	bHasTangents = bWithTangents && PointType == (uint8)ESplinePointType::CurveCustomTangent;
+
+	// Round-trip through the wire format, so the server generates its segments from the same values as the clients.
+	FBitWriter Writer(0, true);
+	bool bSuccess = true;
+	NetSerialize(Writer, nullptr, bSuccess);
+
+	FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+	NetSerialize(Reader, nullptr, bSuccess);
+}
+
+void FAedificSplinePointEdit::Apply(USplineComponent* Spline) const
+{
+	Spline->SetLocationAtSplinePoint(PointIndex, Location, ESplineCoordinateSpace::Local, false);
+	Spline->SetRotationAtSplinePoint(PointIndex, Rotation, ESplineCoordinateSpace::Local, false);
+	Spline->SetScaleAtSplinePoint(PointIndex, Scale, false);
+
+	if (bHasTangents)
+	{
+		Spline->SetTangentsAtSplinePoint(PointIndex, ArriveTangent, LeaveTangent, ESplineCoordinateSpace::Local, false);
+	}
+
+	// Last, setting tangents turns the point into a custom tangent one.
+	Spline->SetSplinePointType(PointIndex, (ESplinePointType::Type)PointType, false);
+}
+
+bool FAedificSplinePointEdit::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint32 PackedIndex = (uint32)FMath::Max(PointIndex, 0);
+	Ar.SerializeIntPacked(PackedIndex);
+	PointIndex = (int32)PackedIndex;
+
+	Ar.SerializeIntPacked(Sequence);
+
+	// Spline point types fit in 3 bits.
+	Ar.SerializeBits(&PointType, 3);
+
+	uint8 bTangents = bHasTangents ? 1 : 0;
+	Ar.SerializeBits(&bTangents, 1);
+	bHasTangents = (bTangents != 0);
+
+	bOutSuccess = SerializePackedVector<10, 27>(Location, Ar);
+
+	if (bHasTangents)
+	{
+		bOutSuccess &= SerializePackedVector<10, 27>(ArriveTangent, Ar);
+		bOutSuccess &= SerializePackedVector<10, 27>(LeaveTangent, Ar);
+	}
+
+	Rotation.SerializeCompressedShort(Ar);
+	bOutSuccess &= SerializePackedVector<100, 30>(Scale, Ar);
+
+	return true;
+}
+
+FAedificSplineEdits::FAedificSplineEdits()
+{
+	Owner = nullptr;
+	Sequence = 0;
+}
+
+const FAedificSplinePointEdit& FAedificSplineEdits::RecordPoint(const USplineComponent* Spline, const int32 PointIndex, const bool bWithTangents)
+{
+	int32& ItemIndex = PointItems.FindOrAdd(PointIndex, INDEX_NONE);
+	if (ItemIndex == INDEX_NONE)
+	{
+		ItemIndex = Items.AddDefaulted();
+	}
+
+	FAedificSplinePointEdit& Edit = Items[ItemIndex];
+	Edit.Sequence = ++Sequence;
+	Edit.Capture(Spline, PointIndex, bWithTangents);
+
+	MarkItemDirty(Edit);
+
+	return Edit;
+}
+
+const FAedificSplinePointEdit* FAedificSplineEdits::FindPoint(const int32 PointIndex) const
+{
+	const int32* ItemIndex = PointItems.Find(PointIndex);
+	return ItemIndex ? &Items[*ItemIndex] : nullptr;
+}
+
+void FAedificSplineEdits::PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize)
+{
+	ReceivedItems.Append(AddedIndices.GetData(), AddedIndices.Num());
+}
+
+void FAedificSplineEdits::PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize)
+{
+	ReceivedItems.Append(ChangedIndices.GetData(), ChangedIndices.Num());
+}
+
+void FAedificSplineEdits::PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters)
+{
+	if (ReceivedItems.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FAedificSplinePointEdit> Received;
+	Received.Reserve(ReceivedItems.Num());
+
+	for (const int32 ItemIndex : ReceivedItems)
+	{
+		if (Items.IsValidIndex(ItemIndex))
+		{
+			const FAedificSplinePointEdit& Edit = Items[ItemIndex];
+			PointItems.Add(Edit.PointIndex, ItemIndex);
+			Sequence = FMath::Max(Sequence, Edit.Sequence);
+			Received.Add(Edit);
+		}
+	}
+
+	ReceivedItems.Reset();
+
+	// Every point of the update is applied at once, so the segments are only regenerated once.
+	if (Owner)
+	{
+		Owner->ApplySplineEdits(Received);
+	}
+}
@@ -0,0 +1,288 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificSplineSampler.h"
+#include "Aedific.h"
+#include "AedificSplineContinuum.h"
+
+#include <Components/SplineComponent.h>
+#include <EngineUtils.h>
+#include <HAL/IConsoleManager.h>
+
+/** Returns the curve points bounding a segment, and the input key length of that segment. */
+template<typename T>
+static float GetSegmentPoints(const FInterpCurve<T>& Curve, const int32 Segment, const FInterpCurvePoint<T>*& OutPrevPoint, const FInterpCurvePoint<T>*& OutNextPoint)
+{
+	const int32 NumPoints = Curve.Points.Num();
+	const bool bClosingSegment = (Segment == NumPoints - 1);
+
+	OutPrevPoint = &Curve.Points[Segment];
+	OutNextPoint = bClosingSegment ? &Curve.Points[0] : &Curve.Points[Segment + 1];
+
+	return bClosingSegment ? Curve.LoopKeyOffset : OutNextPoint->InVal - OutPrevPoint->InVal;
+}
+
+/** Evaluates a curve within a known segment, as FInterpCurve::Eval() does after its search. */
+template<typename T>
+static T EvalSegment(const FInterpCurve<T>& Curve, const int32 Segment, const float Key)
+{
+	const FInterpCurvePoint<T>* PrevPoint;
+	const FInterpCurvePoint<T>* NextPoint;
+	const float Diff = GetSegmentPoints(Curve, Segment, PrevPoint, NextPoint);
+
+	if (Diff <= 0.f || PrevPoint->InterpMode == CIM_Constant)
+	{
+		return PrevPoint->OutVal;
+	}
+
+	const float Alpha = (Key - PrevPoint->InVal) / Diff;
+
+	if (PrevPoint->InterpMode == CIM_Linear)
+	{
+		return FMath::Lerp(PrevPoint->OutVal, NextPoint->OutVal, Alpha);
+	}
+
+	return FMath::CubicInterp(PrevPoint->OutVal, PrevPoint->LeaveTangent * Diff, NextPoint->OutVal, NextPoint->ArriveTangent * Diff, Alpha);
+}
+
+/** Evaluates a curve's derivative within a known segment, as FInterpCurve::EvalDerivative() does after its search. */
+static FVector EvalSegmentDerivative(const FInterpCurveVector& Curve, const int32 Segment, const float Key)
+{
+	const FInterpCurvePoint<FVector>* PrevPoint;
+	const FInterpCurvePoint<FVector>* NextPoint;
+	const float Diff = GetSegmentPoints(Curve, Segment, PrevPoint, NextPoint);
+
+	if (Diff <= 0.f || PrevPoint->InterpMode == CIM_Constant)
+	{
+		return FVector::ZeroVector;
+	}
+
+	if (PrevPoint->InterpMode == CIM_Linear)
+	{
+		return (NextPoint->OutVal - PrevPoint->OutVal) / Diff;
+	}
+
+	const float Alpha = (Key - PrevPoint->InVal) / Diff;
+
+	return FMath::CubicInterpDerivative(PrevPoint->OutVal, PrevPoint->LeaveTangent * Diff, NextPoint->OutVal, NextPoint->ArriveTangent * Diff, Alpha) / Diff;
+}
+
+/** Integrates the curve's length between two input keys of a segment, with a 5-point Gauss-Legendre quadrature. */
+static float GetArcLength(const FInterpCurveVector& Curve, const int32 Segment, const float StartKey, const float EndKey)
+{
+	static const float Abscissae[5] = { 0.f, -0.538469310105683f, 0.538469310105683f, -0.906179845938664f, 0.906179845938664f };
+	static const float Weights[5] = { 0.568888888888889f, 0.478628670499366f, 0.478628670499366f, 0.236926885056189f, 0.236926885056189f };
+
+	const float HalfRange = (EndKey - StartKey) * 0.5f;
+	const float Center = (EndKey + StartKey) * 0.5f;
+
+	float Length = 0.f;
+	for (int32 i = 0; i < 5; ++i)
+	{
+		Length += EvalSegmentDerivative(Curve, Segment, Center + HalfRange * Abscissae[i]).Size() * Weights[i];
+	}
+
+	return Length * HalfRange;
+}
+
+FAedificSplineSampler::FAedificSplineSampler()
+{
+	DefaultUpVector = FVector::UpVector;
+	NumSegments = 0;
+	StepsPerSegment = DefaultStepsPerSegment;
+}
+
+void FAedificSplineSampler::Build(const USplineComponent* Spline, const int32 InStepsPerSegment)
+{
+	Position = Spline->GetSplinePointsPosition();
+	Rotation = Spline->GetSplinePointsRotation();
+	Scale = Spline->GetSplinePointsScale();
+	DefaultUpVector = Spline->GetDefaultUpVector(ESplineCoordinateSpace::Local);
+	StepsPerSegment = FMath::Max(InStepsPerSegment, 1);
+
+	const int32 NumPoints = Position.Points.Num();
+	NumSegments = (NumPoints < 2) ? 0 : (Position.bIsLooped ? NumPoints : NumPoints - 1);
+
+	TableDistances.Reset(NumSegments * StepsPerSegment + 1);
+	TableKeys.Reset(NumSegments * StepsPerSegment + 1);
+
+	if (NumSegments == 0)
+	{
+		return;
+	}
+
+	float Distance = 0.f;
+	TableDistances.Add(Distance);
+	TableKeys.Add(Position.Points[0].InVal);
+
+	for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+	{
+		const FInterpCurvePoint<FVector>* PrevPoint;
+		const FInterpCurvePoint<FVector>* NextPoint;
+		const float Diff = GetSegmentPoints(Position, Segment, PrevPoint, NextPoint);
+
+		float PrevKey = PrevPoint->InVal;
+		for (int32 Step = 1; Step <= StepsPerSegment; ++Step)
+		{
+			const float Key = PrevPoint->InVal + Diff * ((float)Step / (float)StepsPerSegment);
+			Distance += GetArcLength(Position, Segment, PrevKey, Key);
+			PrevKey = Key;
+
+			TableDistances.Add(Distance);
+			TableKeys.Add(Key);
+		}
+	}
+}
+
+float FAedificSplineSampler::GetDistanceAtSplinePoint(const int32 PointIndex) const
+{
+	if (NumSegments == 0)
+	{
+		return 0.f;
+	}
+
+	return TableDistances[FMath::Clamp(PointIndex, 0, NumSegments) * StepsPerSegment];
+}
+
+FAedificSplineSample FAedificSplineSampler::SampleAtDistance(const float Distance) const
+{
+	// Start the search from the entry the distance should be in, assuming an even spacing.
+	int32 Cursor = (GetLength() > 0.f) ? FMath::Clamp(FMath::FloorToInt(Distance / GetLength() * (TableDistances.Num() - 1)), 0, TableDistances.Num() - 2) : 0;
+
+	return SampleAtDistance(Distance, Cursor);
+}
+
+void FAedificSplineSampler::SampleAtDistances(TConstArrayView<float> SortedDistances, TArrayView<FAedificSplineSample> OutSamples) const
+{
+	check(SortedDistances.Num() == OutSamples.Num());
+
+	int32 Cursor = 0;
+	for (int32 i = 0; i < SortedDistances.Num(); ++i)
+	{
+		OutSamples[i] = SampleAtDistance(SortedDistances[i], Cursor);
+	}
+}
+
+FAedificSplineSample FAedificSplineSampler::SampleAtDistance(const float Distance, int32& Cursor) const
+{
+	FAedificSplineSample Sample;
+	Sample.Distance = Distance;
+
+	if (NumSegments == 0)
+	{
+		if (Position.Points.Num() > 0)
+		{
+			Sample.Location = Position.Points[0].OutVal;
+		}
+
+		return Sample;
+	}
+
+	const float ClampedDistance = FMath::Clamp(Distance, 0.f, GetLength());
+
+	// Move the cursor to the table interval holding the distance. Sorted distances only ever move it forward.
+	const int32 LastInterval = TableDistances.Num() - 2;
+	while (Cursor < LastInterval && TableDistances[Cursor + 1] <= ClampedDistance)
+	{
+		++Cursor;
+	}
+
+	while (Cursor > 0 && TableDistances[Cursor] > ClampedDistance)
+	{
+		--Cursor;
+	}
+
+	const int32 Segment = FMath::Min(Cursor / StepsPerSegment, NumSegments - 1);
+	const float IntervalLength = TableDistances[Cursor + 1] - TableDistances[Cursor];
+	const float IntervalAlpha = (IntervalLength > SMALL_NUMBER) ? (ClampedDistance - TableDistances[Cursor]) / IntervalLength : 0.f;
+
+	float Key = FMath::Lerp(TableKeys[Cursor], TableKeys[Cursor + 1], IntervalAlpha);
+
+	// Refine the linear guess with a Newton step on the arc-length.
+	const float Speed = EvalSegmentDerivative(Position, Segment, Key).Size();
+	if (Speed > SMALL_NUMBER)
+	{
+		const float Error = TableDistances[Cursor] + GetArcLength(Position, Segment, TableKeys[Cursor], Key) - ClampedDistance;
+		Key = FMath::Clamp(Key - Error / Speed, TableKeys[Cursor], TableKeys[Cursor + 1]);
+	}
+
+	Sample.InputKey = Key;
+	Sample.Location = EvalSegment(Position, Segment, Key);
+	Sample.Tangent = EvalSegmentDerivative(Position, Segment, Key);
+	Sample.Scale = EvalSegment(Scale, Segment, Key);
+
+	// Same frame as USplineComponent::GetQuaternionAtSplineInputKey().
+	FQuat Quat = EvalSegment(Rotation, Segment, Key);
+	Quat.Normalize();
+
+	const FVector UpVector = Quat.RotateVector(DefaultUpVector);
+	Sample.Rotation = FRotationMatrix::MakeFromXZ(Sample.Tangent.GetSafeNormal(), UpVector).ToQuat();
+
+	return Sample;
+}
+
+static void BenchmarkSampler(const TArray<FString>& Args, UWorld* World)
+{
+	static const int32 SampleCounts[] = { 1000, 10000, 100000 };
+
+	for (TActorIterator<AAedificSplineContinuum> It(World); It; ++It)
+	{
+		const USplineComponent* Spline = It->GetSplineComponent();
+		if (!Spline || Spline->GetNumberOfSplinePoints() < 2)
+		{
+			continue;
+		}
+
+		for (const int32 NumSamples : SampleCounts)
+		{
+			const float SplineLength = Spline->GetSplineLength();
+
+			TArray<float> Distances;
+			Distances.SetNumUninitialized(NumSamples);
+			for (int32 i = 0; i < NumSamples; ++i)
+			{
+				Distances[i] = SplineLength * (float)i / (float)(NumSamples - 1);
+			}
+
+			// Per-call path, as the generators used to query the spline component.
+			TArray<FVector> Locations;
+			Locations.SetNumUninitialized(NumSamples);
+
+			const double PerCallStart = FPlatformTime::Seconds();
+			for (int32 i = 0; i < NumSamples; ++i)
+			{
+				Locations[i] = Spline->GetLocationAtDistanceAlongSpline(Distances[i], ESplineCoordinateSpace::Local);
+				Spline->GetTangentAtDistanceAlongSpline(Distances[i], ESplineCoordinateSpace::Local);
+				Spline->GetQuaternionAtDistanceAlongSpline(Distances[i], ESplineCoordinateSpace::Local);
+				Spline->GetScaleAtDistanceAlongSpline(Distances[i]);
+			}
+			const double PerCallTime = FPlatformTime::Seconds() - PerCallStart;
+
+			// Batched path.
+			TArray<FAedificSplineSample> Samples;
+			Samples.SetNum(NumSamples);
+
+			const double BuildStart = FPlatformTime::Seconds();
+			FAedificSplineSampler Sampler;
+			Sampler.Build(Spline);
+			const double BuildTime = FPlatformTime::Seconds() - BuildStart;
+
+			const double SweepStart = FPlatformTime::Seconds();
+			Sampler.SampleAtDistances(Distances, Samples);
+			const double SweepTime = FPlatformTime::Seconds() - SweepStart;
+
+			float MaxError = 0.f;
+			for (int32 i = 0; i < NumSamples; ++i)
+			{
+				MaxError = FMath::Max(MaxError, (float)FVector::Dist(Locations[i], Samples[i].Location));
+			}
+
+			UE_LOG(LogAedific, Display, TEXT("%s: %d samples, per-call %.3f ms, sampler %.3f ms (+%.3f ms build), max deviation %.3f cm."),
+				*It->GetName(), NumSamples, PerCallTime * 1000.0, SweepTime * 1000.0, BuildTime * 1000.0, MaxError);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkSamplerCommand(
+	TEXT("Aedific.BenchmarkSampler"),
+	TEXT("Compares the batched spline sampler against per-call spline component queries on every continuum, at 1k, 10k and 100k samples."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchmarkSampler));
@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificInstancedSplineMeshComponent.h"
+#include "AedificSplineTypes.h"
+
+#include <Engine/StaticMesh.h>
+#include <Misc/AutomationTest.h>
+#include <UObject/Package.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Segments covering the edge cases of the record layout. */
+static TArray<FAedificMeshSegment> MakeTestSegments()
+{
+	TArray<FAedificMeshSegment> Segments;
+
+	FAedificMeshSegment& Straight = Segments.AddDefaulted_GetRef();
+	Straight.StartLocation = FVector(0.f, 0.f, 0.f);
+	Straight.EndLocation = FVector(100.f, 0.f, 0.f);
+	Straight.StartTangent = FVector(100.f, 0.f, 0.f);
+	Straight.EndTangent = FVector(100.f, 0.f, 0.f);
+
+	// Zero tangents, the curve has no direction at its ends.
+	FAedificMeshSegment& ZeroTangent = Segments.AddDefaulted_GetRef();
+	ZeroTangent.StartLocation = FVector(100.f, 0.f, 0.f);
+	ZeroTangent.EndLocation = FVector(200.f, 50.f, 0.f);
+
+	// Rolls past a full turn and below a negative half turn are packed as they are, not wrapped.
+	FAedificMeshSegment& RollWrap = Segments.AddDefaulted_GetRef();
+	RollWrap.StartLocation = FVector(200.f, 50.f, 0.f);
+	RollWrap.EndLocation = FVector(300.f, 50.f, 100.f);
+	RollWrap.StartTangent = FVector(100.f, 0.f, 50.f);
+	RollWrap.EndTangent = FVector(0.f, 0.f, 100.f);
+	RollWrap.UpVector = FVector(0.f, 1.f, 0.f);
+	RollWrap.StartRollDegrees = 359.5f;
+	RollWrap.EndRollDegrees = -540.f;
+
+	// Non-uniform, non-unit scales.
+	FAedificMeshSegment& Scaled = Segments.AddDefaulted_GetRef();
+	Scaled.StartLocation = FVector(300.f, 50.f, 100.f);
+	Scaled.EndLocation = FVector(300.f, 200.f, 100.f);
+	Scaled.StartTangent = FVector(0.f, 150.f, 0.f);
+	Scaled.EndTangent = FVector(-50.f, 150.f, 0.f);
+	Scaled.StartScale = FVector2D(0.25f, 3.f);
+	Scaled.EndScale = FVector2D(2.5f, 0.5f);
+
+	return Segments;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAedificInstancedSegmentRecordTest, "Aedific.InstancedSplineMesh.Record", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAedificInstancedSegmentRecordTest::RunTest(const FString& Parameters)
+{
+	const FBox MeshBounds(FVector(-50.f, -25.f, 0.f), FVector(50.f, 25.f, 10.f));
+
+	for (const FAedificMeshSegment& Segment : MakeTestSegments())
+	{
+		float Record[UAedificInstancedSplineMeshComponent::RecordSize];
+		FTransform InstanceTransform;
+		UAedificInstancedSplineMeshComponent::PackSegment(Segment, MeshBounds, MakeArrayView(Record), InstanceTransform);
+
+		bool bFinite = true;
+		for (const float Value : Record)
+		{
+			bFinite &= FMath::IsFinite(Value);
+		}
+
+		TestTrue(TEXT("Record is finite"), bFinite);
+		TestTrue(TEXT("Record unpacks to its segment"), UAedificInstancedSplineMeshComponent::UnpackSegment(Record).Equals(Segment, KINDA_SMALL_NUMBER * 100.f));
+		TestTrue(TEXT("Instance transform is valid"), InstanceTransform.IsValid());
+		TestEqual(TEXT("Mesh length"), Record[UAedificInstancedSplineMeshComponent::MeshLengthOffset], 100.f);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAedificInstancedSegmentValidationTest, "Aedific.InstancedSplineMesh.Validation", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAedificInstancedSegmentValidationTest::RunTest(const FString& Parameters)
+{
+	UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Engine cube mesh"), Mesh))
+	{
+		return false;
+	}
+
+	// Left unregistered, instances and their custom data don't need a scene nor a GPU.
+	UAedificInstancedSplineMeshComponent* Component = NewObject<UAedificInstancedSplineMeshComponent>(GetTransientPackage());
+	Component->SetStaticMesh(Mesh);
+
+	TArray<FAedificMeshSegment> Segments = MakeTestSegments();
+	for (int32 i = 0; i < Segments.Num(); ++i)
+	{
+		Component->SetSegment(i, Segments[i]);
+	}
+
+	TestEqual(TEXT("Instance count"), Component->GetInstanceCount(), Segments.Num());
+	TestTrue(TEXT("Records match their segments"), Component->ValidateSegments(Segments));
+
+	// Updating a segment in place re-packs its record.
+	Segments[1].EndRollDegrees = 45.f;
+	Component->SetSegment(1, Segments[1]);
+	TestTrue(TEXT("Updated record matches its segment"), Component->ValidateSegments(Segments));
+
+	// A record no longer matching its segment is caught.
+	Segments[2].StartScale = FVector2D(1.f, 1.f);
+	AddExpectedError(TEXT("doesn't match its segment"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestFalse(TEXT("Outdated record is caught"), Component->ValidateSegments(Segments));
+
+	Component->TruncateSegments(2);
+	Segments.SetNum(2);
+	TestTrue(TEXT("Truncated records match their segments"), Component->ValidateSegments(Segments));
+
+	Component->MarkAsGarbage();
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,98 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificRotationMinimizingFrames.h"
+
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Largest angle between the kernel's normals and the reference ones, in degrees. */
+static constexpr double MaxNormalDeviation = 0.1;
+
+/**
+ * Frames along a torus knot, closed on itself and twisting in every direction, offset far from the origin so float
+ * positions would lose precision. Returns the largest deviation of the kernel's normals from the reference ones.
+ */
+static double MeasureNormalDeviation(const int32 NumFrames, const bool bClosedLoop, FAedificVectorStreams& OutNormals)
+{
+	const FVector Offset(2000000.0, 2000000.0, 0.0);
+
+	TArray<FVector> Positions; Positions.SetNumUninitialized(NumFrames);
+	TArray<FVector> Tangents; Tangents.SetNumUninitialized(NumFrames);
+
+	for (int32 k = 0; k < NumFrames; ++k)
+	{
+		const double T = UE_DOUBLE_TWO_PI * k / (NumFrames - 1);
+		const double Radius = 1000.0 + 300.0 * FMath::Cos(3.0 * T);
+
+		Positions[k] = Offset + FVector(Radius * FMath::Cos(2.0 * T), Radius * FMath::Sin(2.0 * T), 300.0 * FMath::Sin(3.0 * T));
+	}
+
+	for (int32 k = 0; k < NumFrames; ++k)
+	{
+		const int32 Prev = (k > 0) ? k - 1 : (bClosedLoop ? NumFrames - 2 : 0);
+		const int32 Next = (k < NumFrames - 1) ? k + 1 : (bClosedLoop ? 1 : NumFrames - 1);
+		Tangents[k] = (Positions[Next] - Positions[Prev]).GetSafeNormal();
+	}
+
+	TArray<FVector> ReferenceNormals; ReferenceNormals.SetNumUninitialized(NumFrames);
+	FAedificRotationMinimizingFrames::PropagateReference(Tangents, ReferenceNormals, bClosedLoop);
+
+	FAedificVectorStreams TangentStreams; TangentStreams.SetNumUninitialized(NumFrames);
+	OutNormals.SetNumUninitialized(NumFrames);
+
+	for (int32 k = 0; k < NumFrames; ++k)
+	{
+		TangentStreams.Set(k, Tangents[k]);
+	}
+
+	FAedificRotationMinimizingFrames::Propagate(Positions, TangentStreams, OutNormals, 0);
+	if (bClosedLoop)
+	{
+		FAedificRotationMinimizingFrames::CloseLoop(TangentStreams, OutNormals);
+	}
+
+	double MaxDeviation = 0.0;
+	for (int32 k = 0; k < NumFrames; ++k)
+	{
+		const double Cos = FMath::Clamp(FVector::DotProduct(ReferenceNormals[k], OutNormals.Get(k)), -1.0, 1.0);
+		MaxDeviation = FMath::Max(MaxDeviation, FMath::RadiansToDegrees(FMath::Acos(Cos)));
+	}
+
+	return MaxDeviation;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAedificFramesOpenTest, "Aedific.Frames.Open", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAedificFramesOpenTest::RunTest(const FString& Parameters)
+{
+	for (const int32 NumFrames : { 1000, 10000 })
+	{
+		FAedificVectorStreams Normals;
+		const double MaxDeviation = MeasureNormalDeviation(NumFrames, false, Normals);
+
+		TestTrue(FString::Printf(TEXT("%d frames deviate by %.4f degrees at most"), NumFrames, MaxDeviation), MaxDeviation <= MaxNormalDeviation);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAedificFramesClosedTest, "Aedific.Frames.Closed", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAedificFramesClosedTest::RunTest(const FString& Parameters)
+{
+	for (const int32 NumFrames : { 1000, 10000 })
+	{
+		FAedificVectorStreams Normals;
+		const double MaxDeviation = MeasureNormalDeviation(NumFrames, true, Normals);
+
+		TestTrue(FString::Printf(TEXT("%d frames deviate by %.4f degrees at most"), NumFrames, MaxDeviation), MaxDeviation <= MaxNormalDeviation);
+
+		// The loop's last frame matches its first one, without any twist left.
+		TestEqual(FString::Printf(TEXT("%d frames close on the first normal"), NumFrames), Normals.Get(NumFrames - 1), Normals.Get(0), 1.e-3f);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
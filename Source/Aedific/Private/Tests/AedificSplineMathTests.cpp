@@ -0,0 +1,91 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificSplineMath.h"
+
+#include <Misc/AutomationTest.h>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAedificMathOpenTangentsTest, "Aedific.Math.OpenTangents", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAedificMathOpenTangentsTest::RunTest(const FString& Parameters)
+{
+	// Evenly spaced points on a line get tangents along the line, as long as the spacing.
+	const FVector Locations[] = { FVector(0, 0, 0), FVector(100, 0, 0), FVector(200, 0, 0), FVector(300, 0, 0) };
+	FVector Arrive[4], Leave[4];
+	FAedificSplineMath::ComputeTangents(Locations, false, 1.f, Arrive, Leave);
+
+	TestTrue(TEXT("Start arrive tangent is zero"), Arrive[0].IsZero());
+	TestEqual(TEXT("Start leave tangent"), Leave[0], FVector(100, 0, 0));
+	TestEqual(TEXT("Interior arrive tangent"), Arrive[1], FVector(100, 0, 0));
+	TestEqual(TEXT("Interior leave tangent"), Leave[1], FVector(100, 0, 0));
+	TestEqual(TEXT("End arrive tangent"), Arrive[3], FVector(100, 0, 0));
+	TestTrue(TEXT("End leave tangent is zero"), Leave[3].IsZero());
+
+	FAedificSplineMath::ComputeTangents(Locations, false, 0.f, Arrive, Leave);
+	TestTrue(TEXT("Zero scale gives zero tangents"), Arrive[1].IsZero() && Leave[1].IsZero());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAedificMathClosedTangentsTest, "Aedific.Math.ClosedTangents", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAedificMathClosedTangentsTest::RunTest(const FString& Parameters)
+{
+	// Closed square: every corner's tangent follows the diagonal between its neighbors.
+	const FVector Locations[] = { FVector(0, 0, 0), FVector(100, 0, 0), FVector(100, 100, 0), FVector(0, 100, 0) };
+	FVector Arrive[4], Leave[4];
+	FAedificSplineMath::ComputeTangents(Locations, true, 1.f, Arrive, Leave);
+
+	TestEqual(TEXT("First corner leave tangent"), Leave[0], FVector(1, -1, 0).GetSafeNormal() * 100.0);
+	TestEqual(TEXT("First corner arrive tangent"), Arrive[0], FVector(1, -1, 0).GetSafeNormal() * 100.0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAedificMathRollTest, "Aedific.Math.Roll", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAedificMathRollTest::RunTest(const FString& Parameters)
+{
+	// A frame matching the rotation has no roll, a frame rolled by 30 degrees around its direction rolls by 30 degrees.
+	const FQuat Rotation = FRotator(10.f, 45.f, 0.f).Quaternion();
+	TestEqual(TEXT("Relative roll of an aligned frame"), FAedificSplineMath::GetRelativeRoll(Rotation, Rotation.GetAxisX(), Rotation.GetAxisY(), Rotation.GetAxisZ()), 0.f, 1e-3f);
+
+	const FQuat Rolled = Rotation * FQuat(FVector::ForwardVector, FMath::DegreesToRadians(30.f));
+	TestEqual(TEXT("Relative roll of a rolled frame"), FMath::Abs(FAedificSplineMath::GetRelativeRoll(Rotation, Rolled.GetAxisX(), Rolled.GetAxisY(), Rolled.GetAxisZ())), 30.f, 1e-2f);
+
+	// Rolling the reference up-vector by 90 degrees around the tangent gives a 90 degrees roll, either way.
+	TestEqual(TEXT("Roll between perpendicular normals"), FMath::Abs(FAedificSplineMath::CalculateRollInDegrees(FVector::ForwardVector, FVector::RightVector, FVector::UpVector)), 90.f, 1e-2f);
+	TestEqual(TEXT("Roll between identical normals"), FAedificSplineMath::CalculateRollInDegrees(FVector::ForwardVector, FVector::UpVector, FVector::UpVector), 0.f, 1e-3f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAedificMathTwistTest, "Aedific.Math.Twist", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAedificMathTwistTest::RunTest(const FString& Parameters)
+{
+	// Turning without rolling isn't a twist, rolling is.
+	TestEqual(TEXT("Twist of a flat turn"), FAedificSplineMath::GetTwistDegrees(FVector::ForwardVector, FVector::UpVector, FVector::RightVector, FVector::UpVector), 0.f, 1e-2f);
+	TestEqual(TEXT("Twist of a roll"), FAedificSplineMath::GetTwistDegrees(FVector::ForwardVector, FVector::UpVector, FVector::ForwardVector, FVector::RightVector), 90.f, 1e-2f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAedificMathSegmentRollsTest, "Aedific.Math.SegmentRolls", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FAedificMathSegmentRollsTest::RunTest(const FString& Parameters)
+{
+	// Segments between identical frames have no roll.
+	FVector UpVector;
+	float StartRoll, EndRoll;
+	FAedificSplineMath::ComputeFrameSegmentRolls(FVector::ForwardVector, FVector::UpVector, FVector::ForwardVector, FVector::UpVector, UpVector, StartRoll, EndRoll);
+
+	TestEqual(TEXT("Up vector of identical frames"), UpVector, FVector::UpVector);
+	TestEqual(TEXT("Start roll of identical frames"), StartRoll, 0.f, 1e-3f);
+	TestEqual(TEXT("End roll of identical frames"), EndRoll, 0.f, 1e-3f);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
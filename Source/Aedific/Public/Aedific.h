@@ -1,3 +1,10 @@
 // Copyright (c) 2025 Ampere Games.
 
 #pragma once
+
+#include <Logging/LogMacros.h>
+#include <Stats/Stats.h>
+
+AEDIFIC_API DECLARE_LOG_CATEGORY_EXTERN(LogAedific, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("Aedific"), STATGROUP_Aedific, STATCAT_Advanced);
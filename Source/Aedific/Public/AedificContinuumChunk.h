@@ -0,0 +1,56 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include <GameFramework/Actor.h>
+
+#include "AedificContinuumChunk.generated.h"
+
+class UStaticMeshComponent;
+
+/**
+ * Holds the baked meshes of a range of segments of a continuum, spatially loaded so World Partition streams it
+ * independently from the rest of the continuum, and builds its HLOD proxy from it.
+ * Spawned and updated by the continuum's bake, not meant to be edited by hand.
+ */
+UCLASS(ClassGroup = Aedific, HideCategories = (Actor, Input, Networking, Physics, Replication), MinimalAPI, NotBlueprintable, NotPlaceable)
+class AAedificContinuumChunk : public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Sets default values for this actor's properties. */
+	AAedificContinuumChunk();
+
+	/** Component displaying the chunk's baked mesh. */
+	UStaticMeshComponent* GetMeshComponent() const { return MeshComponent; }
+
+#if WITH_EDITORONLY_DATA
+	/** If the chunk holds the given segments. */
+	bool HasSegmentRange(const int32 InFirstSegment, const int32 InNumSegments) const { return FirstSegment == InFirstSegment && NumSegments == InNumSegments; }
+
+	/** Sets the segments the chunk holds. */
+	void SetSegmentRange(const int32 InFirstSegment, const int32 InNumSegments)
+	{
+		FirstSegment = InFirstSegment;
+		NumSegments = InNumSegments;
+	}
+#endif // WITH_EDITORONLY_DATA
+
+protected:
+
+	/** The Actor's root component, displaying the baked mesh. */
+	UPROPERTY(VisibleInstanceOnly, Category = "Aedific")
+	TObjectPtr<UStaticMeshComponent> MeshComponent;
+
+#if WITH_EDITORONLY_DATA
+	/** Index of the first segment of the continuum baked into this chunk. */
+	UPROPERTY(VisibleInstanceOnly, Category = "Aedific")
+	int32 FirstSegment;
+
+	/** Amount of segments baked into this chunk. */
+	UPROPERTY(VisibleInstanceOnly, Category = "Aedific")
+	int32 NumSegments;
+#endif // WITH_EDITORONLY_DATA
+};
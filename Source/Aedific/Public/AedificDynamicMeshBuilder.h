@@ -0,0 +1,102 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include "AedificSplineTypes.h"
+
+#include <DynamicMesh/DynamicMesh3.h>
+
+class UStaticMesh;
+
+/**
+ * Render geometry of a mesh's LOD0, copied once on the game thread so chunks can be deformed on worker threads.
+ * Vertices are the render vertices, already split wherever normals, tangents or UVs differ.
+ */
+struct FAedificDynamicMeshSource
+{
+	/** Vertex attributes, in the mesh's space. */
+	TArray<FVector3f> Positions;
+	TArray<FVector3f> Normals;
+	TArray<FVector3f> Tangents;
+	TArray<float> BinormalSigns;
+	TArray<FVector2f> UVs;
+
+	/** Vertices of every triangle, three per triangle. */
+	TArray<int32> Indices;
+
+	/** Material slot of every triangle. */
+	TArray<int32> MaterialIDs;
+
+	/** Start of the mesh along X, and its length, mapped to each segment. */
+	float MinX;
+	float MeshLength;
+
+	FAedificDynamicMeshSource()
+	{
+		MinX =			0.f;
+		MeshLength =	0.f;
+	}
+};
+
+/** Chunk of consecutive segments deformed into a single dynamic mesh. */
+struct FAedificDynamicMeshChunk
+{
+	/** Index of the chunk. */
+	int32 ChunkIndex;
+
+	/** Segments of the chunk, in the Actor's local space. */
+	TArray<FAedificMeshSegment> Segments;
+
+	/** If the first seam is welded to PreviousSegment. */
+	bool bHasPreviousSegment;
+
+	/** Segment before the chunk, whose end the first seam is welded to. */
+	FAedificMeshSegment PreviousSegment;
+
+	/** Deformed mesh, once built. */
+	UE::Geometry::FDynamicMesh3 Mesh;
+
+	FAedificDynamicMeshChunk()
+	{
+		ChunkIndex =			INDEX_NONE;
+		bHasPreviousSegment =	false;
+	}
+};
+
+/** Chunks of a continuum deformed together on the worker threads. */
+struct FAedificDynamicMeshBuild
+{
+	/** Generation of the build, stale results are discarded when a newer build was launched in the meantime. */
+	uint32 Generation;
+
+	/** Geometry deformed along the segments. */
+	TSharedPtr<const FAedificDynamicMeshSource> Source;
+
+	/** Chunks to build. */
+	TArray<FAedificDynamicMeshChunk> Chunks;
+
+	FAedificDynamicMeshBuild()
+	{
+		Generation = 0;
+	}
+};
+
+/**
+ * Deforms a Static Mesh along mesh segments on the CPU into dynamic meshes, like FAedificMeshBaker, but without the
+ * editor-only mesh descriptions, so continuums can be edited at runtime.
+ */
+class FAedificDynamicMeshBuilder
+{
+public:
+	/**
+	 * Copies the render geometry of the mesh's LOD0. Game thread only.
+	 * Returns nullptr if the geometry can't be read, as in cooked builds when the mesh doesn't allow CPU access.
+	 */
+	static TSharedPtr<const FAedificDynamicMeshSource> ExtractSource(const UStaticMesh* Mesh);
+
+	/** Deforms the source geometry along the chunk's segments into its mesh, with normals, tangents, UVs and material IDs. */
+	static void BuildChunk(const FAedificDynamicMeshSource& Source, FAedificDynamicMeshChunk& Chunk);
+
+	/** Builds every chunk of the build, in parallel. */
+	static void Build(FAedificDynamicMeshBuild& Build);
+};
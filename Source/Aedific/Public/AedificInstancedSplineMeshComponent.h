@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include <Components/InstancedStaticMeshComponent.h>
+
+#include "AedificInstancedSplineMeshComponent.generated.h"
+
+struct FAedificMeshSegment;
+
+/**
+ * Renders every mesh segment of a continuum as instances of a single mesh, in a single draw.
+ *
+ * Each instance carries its segment's spline parameters packed into its custom data, which the material
+ * uses to deform the mesh through AedificDeformSplineMeshVertex() in "/Plugin/Aedific/AedificInstancedSplineMesh.ush".
+ * Instance transforms are only used to bound the deformed segments for culling.
+ */
+UCLASS(ClassGroup = Aedific, MinimalAPI)
+class UAedificInstancedSplineMeshComponent : public UInstancedStaticMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Offsets of each segment parameter in a packed record, which AedificLoadSplineSegment() in
+	 * "/Plugin/Aedific/AedificInstancedSplineMesh.ush" mirrors as AEDIFIC_RECORD_* defines.
+	 */
+	static constexpr int32 StartLocationOffset = 0;
+	static constexpr int32 StartTangentOffset = 3;
+	static constexpr int32 EndLocationOffset = 6;
+	static constexpr int32 EndTangentOffset = 9;
+	static constexpr int32 UpVectorOffset = 12;
+	static constexpr int32 StartRollOffset = 15;
+	static constexpr int32 EndRollOffset = 16;
+	static constexpr int32 StartScaleOffset = 17;
+	static constexpr int32 EndScaleOffset = 19;
+	static constexpr int32 InstanceOriginOffset = 21;
+	static constexpr int32 InstanceScaleOffset = 24;
+	static constexpr int32 MeshMinXOffset = 27;
+	static constexpr int32 MeshLengthOffset = 28;
+
+	/** Amount of custom data floats making up one packed segment record. */
+	static constexpr int32 RecordSize = MeshLengthOffset + 1;
+
+	/** Sets default values for this component's properties. */
+	UAedificInstancedSplineMeshComponent();
+
+	/**
+	 * Packs the segment into a record, and computes the instance transform mapping the mesh bounds onto the deformed segment's bounds.
+	 * Record layout, in floats:
+	 *  0 StartLocation, 3 StartTangent, 6 EndLocation, 9 EndTangent, 12 UpVector, 15 StartRoll (radians), 16 EndRoll (radians),
+	 *  17 StartScale, 19 EndScale, 21 InstanceOrigin, 24 InstanceScale, 27 MeshMinX, 28 MeshLength.
+	 */
+	static void PackSegment(const FAedificMeshSegment& Segment, const FBox& MeshBounds, TArrayView<float> OutRecord, FTransform& OutInstanceTransform);
+
+	/** Reads a segment back from a packed record. */
+	static FAedificMeshSegment UnpackSegment(TConstArrayView<float> Record);
+
+	/** Sets the segment displayed by the instance at Index, appending a new instance if Index is the next one. */
+	void SetSegment(const int32 Index, const FAedificMeshSegment& Segment);
+
+	/** Removes the instances from Index onwards. */
+	void TruncateSegments(const int32 Index);
+
+	/** Checks the packed records and instances match the segments, without requiring a GPU. */
+	bool ValidateSegments(TConstArrayView<FAedificMeshSegment> Segments) const;
+};
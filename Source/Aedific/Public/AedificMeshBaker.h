@@ -0,0 +1,30 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include "AedificSplineTypes.h"
+
+class UStaticMesh;
+
+/**
+ * Deforms a Static Mesh along mesh segments on the CPU, reproducing what USplineMeshComponent does on the GPU,
+ * so the whole continuum can be baked into plain static meshes.
+ */
+class FAedificMeshBaker
+{
+public:
+	/**
+	 * Computes the transform USplineMeshComponent applies to the mesh slice found at Alpha along the segment.
+	 * The slice's forward axis is X, Alpha is 0 at the segment start and 1 at its end.
+	 */
+	static FTransform CalcSliceTransform(const FAedificMeshSegment& Segment, const float Alpha);
+
+#if WITH_EDITOR
+	/**
+	 * Deforms every LOD of SourceMesh along the segments and builds the result into TargetMesh, with complex collision.
+	 * LODs generated by reduction on the source mesh are generated the same way on the target one.
+	 * If PreviousSegment is provided, the vertices on the first seam are welded to its end.
+	 */
+	static bool BakeSegments(UStaticMesh* SourceMesh, TConstArrayView<FAedificMeshSegment> Segments, const FAedificMeshSegment* PreviousSegment, UStaticMesh* TargetMesh);
+#endif // WITH_EDITOR
+};
@@ -0,0 +1,149 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include <Subsystems/WorldSubsystem.h>
+
+#include "AedificRebuildSubsystem.generated.h"
+
+class AAedificSplineContinuum;
+
+/** Rebuild statistics of the continuums of a world. */
+struct FAedificRebuildStats
+{
+	/** Amount of continuums waiting for their rebuild to start. */
+	int32 QueuedRebuilds;
+
+	/** Amount of continuums having their generated segments applied. */
+	int32 QueuedMaterializations;
+
+	/** Amount of rebuild requests received. */
+	uint32 NumRequests;
+
+	/** Amount of rebuild requests merged into one already queued. */
+	uint32 NumDeduplicated;
+
+	/** Amount of rebuilds completed. */
+	uint32 NumCompleted;
+
+	/** Amount of rebuilds skipped because their inputs matched the last build. */
+	uint32 NumAvoided;
+
+	/** Sum and maximum of the time between a rebuild request and its completion, in seconds. */
+	double TotalLatency;
+	double MaxLatency;
+
+	FAedificRebuildStats()
+	{
+		QueuedRebuilds =			0;
+		QueuedMaterializations =	0;
+		NumRequests =				0;
+		NumDeduplicated =			0;
+		NumCompleted =				0;
+		NumAvoided =				0;
+		TotalLatency =				0.0;
+		MaxLatency =				0.0;
+	}
+
+	double GetAverageLatency() const { return NumCompleted > 0 ? TotalLatency / NumCompleted : 0.0; }
+};
+
+/**
+ * Schedules the mesh rebuilds of every continuum in a world.
+ *
+ * Requests are de-duplicated and started by priority, visible continuums first then the nearest to the viewer,
+ * sharing a single frame budget with the application of the generated segments to the components.
+ */
+UCLASS(MinimalAPI)
+class UAedificRebuildSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//~ Begin of UTickableWorldSubsystem implementation.
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickableInEditor() const override { return true; }
+	//~ End of UTickableWorldSubsystem implementation.
+
+	/** Queues a rebuild of the continuum, merged with its previous request if it's still queued. */
+	void RequestRebuild(AAedificSplineContinuum* Continuum);
+
+	/** Queues the continuum to have its generated segments applied under the frame budget. */
+	void RequestMaterialization(AAedificSplineContinuum* Continuum);
+
+	/** Notifies the continuum's rebuild completed. Returns the time since its request, in seconds, or 0 if it wasn't requested. */
+	double NotifyRebuildFinished(AAedificSplineContinuum* Continuum);
+
+	/** Notifies the continuum's rebuild was abandoned, its request no longer counts towards the latency. */
+	void NotifyRebuildCancelled(AAedificSplineContinuum* Continuum);
+
+	/** Notifies a rebuild was skipped because its inputs matched the last build. */
+	void NotifyRebuildAvoided() { ++Stats.NumAvoided; }
+
+#if WITH_EDITOR
+	/** Notifies an interactive edit of the continuum started, to end it once no edit arrived for a while. */
+	void NotifyInteractiveEdit(AAedificSplineContinuum* Continuum);
+#endif // WITH_EDITOR
+
+	/** Registers a continuum virtualizing its segments, to be updated periodically around the viewers and players. */
+	void RegisterVirtualizedContinuum(AAedificSplineContinuum* Continuum);
+
+	/** Unregisters a continuum virtualizing its segments. */
+	void UnregisterVirtualizedContinuum(AAedificSplineContinuum* Continuum);
+
+	/** Queues a rebuild of every continuum of the world whose meshes are outdated. Returns their amount. */
+	int32 RebuildAllDirty();
+
+	/** Statistics since the last reset. */
+	FAedificRebuildStats GetStats() const;
+
+	/** Resets the statistics, except the queue depths. */
+	void ResetStats();
+
+private:
+
+	/** Orders the rebuild queue by descending priority. */
+	void SortRebuildQueue();
+
+	/** Updates the virtualized continuums whose interval elapsed or which requested it, until EndTime. */
+	void UpdateVirtualization(const double EndTime);
+
+	/** Locations segments are virtualized around: the views rendered last frame and the players' view points. */
+	void GatherVirtualizationSources(TArray<FVector>& OutSources) const;
+
+#if WITH_EDITOR
+	/** Forwards the edits of a continuum's spline, such as spline point drags, to the continuum. */
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+
+	/** Ends the interactive edits that stopped receiving changes, as not every editing tool notifies their end. */
+	void SettleInteractiveEdits();
+
+	/** Continuums being interactively edited. */
+	TArray<TWeakObjectPtr<AAedificSplineContinuum>> InteractiveEdits;
+
+	/** Handle of the OnObjectPropertyChanged binding. */
+	FDelegateHandle ObjectPropertyChangedHandle;
+#endif // WITH_EDITOR
+
+	/** Continuums waiting for their rebuild to start. */
+	TArray<TWeakObjectPtr<AAedificSplineContinuum>> RebuildQueue;
+
+	/** Continuums having their generated segments applied. */
+	TArray<TWeakObjectPtr<AAedificSplineContinuum>> MaterializationQueue;
+
+	/** Continuums virtualizing their segments. */
+	TArray<TWeakObjectPtr<AAedificSplineContinuum>> VirtualizedContinuums;
+
+	/** Time of the next periodic virtualization update. */
+	double NextVirtualizationTime;
+
+	/** Time of the oldest unfinished rebuild request of each continuum. */
+	TMap<TWeakObjectPtr<AAedificSplineContinuum>, double> RequestTimes;
+
+	/** Statistics since the last reset. */
+	FAedificRebuildStats Stats;
+};
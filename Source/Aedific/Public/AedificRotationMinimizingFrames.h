@@ -0,0 +1,69 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+/** Structure-of-arrays storage of vectors, one float stream per axis. Meant for directions, positions lose precision far from the origin. */
+struct FAedificVectorStreams
+{
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+
+	int32 Num() const { return X.Num(); }
+
+	void SetNumUninitialized(const int32 Num)
+	{
+		X.SetNumUninitialized(Num);
+		Y.SetNumUninitialized(Num);
+		Z.SetNumUninitialized(Num);
+	}
+
+	void Reset()
+	{
+		X.Reset();
+		Y.Reset();
+		Z.Reset();
+	}
+
+	FVector Get(const int32 Index) const { return FVector(X[Index], Y[Index], Z[Index]); }
+
+	void Set(const int32 Index, const FVector& Value)
+	{
+		X[Index] = (float)Value.X;
+		Y[Index] = (float)Value.Y;
+		Z[Index] = (float)Value.Z;
+	}
+};
+
+/**
+ * Builds rotation-minimizing frames along sampled spline positions and tangents.
+ *
+ * Uses the double reflection method: each normal is the previous one reflected across the bisecting plane of the
+ * two positions, then across the bisecting plane of the reflected and actual tangents. The reflection planes don't
+ * depend on the normals, so they're computed four frames at a time before the sequential propagation.
+ */
+class AEDIFIC_API FAedificRotationMinimizingFrames
+{
+public:
+	/**
+	 * Propagates the normals downstream from FirstFrame. The first frame's normal is derived from the world up-vector.
+	 * Positions stay in double precision, only the offsets between consecutive frames are reflected in floats.
+	 * If ConvergenceFrame is set, propagation stops past it as soon as a normal matches the one already stored.
+	 * Returns the last frame whose normal was written.
+	 */
+	static int32 Propagate(TConstArrayView<FVector> Positions, const FAedificVectorStreams& Tangents, FAedificVectorStreams& Normals, const int32 FirstFrame, const int32 ConvergenceFrame = INDEX_NONE);
+
+	/**
+	 * Cancels the twist accumulated along a closed loop, whose last frame matches its first one.
+	 * Each normal is rolled around its tangent by its share of the twist angle, in closed form.
+	 */
+	static void CloseLoop(const FAedificVectorStreams& Tangents, FAedificVectorStreams& Normals);
+
+	/**
+	 * Scalar Parallel Transport in double precision, rotating each normal by the rotation between consecutive tangents,
+	 * and closing loops like CloseLoop. The reference the kernel is measured and tested against.
+	 */
+	static void PropagateReference(TConstArrayView<FVector> Tangents, TArrayView<FVector> Normals, const bool bClosedLoop);
+};
@@ -0,0 +1,86 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include "AedificSplineSampler.h"
+#include "AedificSplineTypes.h"
+
+#include <atomic>
+
+/**
+ * Inputs and results of a segment generation.
+ * Only holds copies of the Actor's state, so it can be processed away from the game thread.
+ */
+struct FAedificSegmentBuild
+{
+	/** Snapshot of the spline the segments are generated from. */
+	FAedificSplineSampler Sampler;
+
+	/** Length of a single mesh segment. */
+	float MeshLength;
+
+	/** Length of the spline. */
+	float SplineLength;
+
+	/** Amount of segments to generate. Replaced by the amount actually generated when the segmentation is adaptive. */
+	int32 LoopSize;
+
+	/** Part of the spline that changed since the last build. */
+	FAedificDirtyRange DirtyRange;
+
+	/** Segments of the last build, reused outside of the dirty range. */
+	TArray<FAedificMeshSegment> PreviousSegments;
+
+	/** Inputs of this build, holding the Parallel Transport frames of the last build until they're updated. */
+	FAedificMeshBuildState State;
+
+	/** If this is a coarse preview of an interactive edit. */
+	bool bPreview;
+
+	/** Distances along the spline where each segment starts, followed by the end of the last one. */
+	TArray<float> Boundaries;
+
+	/** Generated segments, LoopSize of them once the build is done. */
+	TArray<FAedificMeshSegment> Segments;
+
+	/** Time spent generating the segments, in seconds. */
+	double BuildTime;
+
+	/** Set when a newer build supersedes this one, its results are then discarded. */
+	std::atomic<bool> bCancelled;
+
+	FAedificSegmentBuild()
+	{
+		MeshLength =	0.f;
+		SplineLength =	0.f;
+		LoopSize =		0;
+		bPreview =		false;
+		BuildTime =		0.0;
+		bCancelled =	false;
+	}
+};
+
+/** Generates the mesh segments of a build, spreading them over the worker threads. */
+class AEDIFIC_API FAedificSegmentBuilder
+{
+public:
+	/** Generates the segments of the build. Returns false if it was cancelled before completion. */
+	static bool Build(FAedificSegmentBuild& Build);
+
+private:
+	/**
+	 * Splits the spline into segments. Fixed segmentation tiles the mesh at its length, or evenly for Parallel Transport.
+	 * Adaptive segmentation greedily makes each segment as long as the chord deviation and twist tolerances allow,
+	 * between a quarter of the mesh length and its maximum stretch.
+	 */
+	static void ComputeBoundaries(FAedificSegmentBuild& Build);
+
+	/** Generates segments oriented by the spline's rotations, only regenerating the ones overlapping the dirty range. */
+	static void BuildSegments(FAedificSegmentBuild& Build);
+
+	/**
+	 * Generates segments oriented by rotation-minimizing frames to ensure smooth rotation along loops.
+	 * Frames are re-propagated from the dirty range downstream until they converge with the ones of the last build.
+	 */
+	static void BuildSegmentsParallelTransport(FAedificSegmentBuild& Build);
+};
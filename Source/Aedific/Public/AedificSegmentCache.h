@@ -0,0 +1,41 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include "AedificSplineTypes.h"
+
+/** Header of a serialized segment cache. */
+struct FAedificSegmentCacheHeader
+{
+	/** Input hash of the build the segments come from. */
+	uint64 InputHash;
+
+	/** Length of a single mesh segment. */
+	float MeshLength;
+
+	/** Length of the spline. */
+	float SplineLength;
+
+	FAedificSegmentCacheHeader()
+	{
+		InputHash =		0;
+		MeshLength =	0.f;
+		SplineLength =	0.f;
+	}
+};
+
+/**
+ * Compact binary form of the generated segments, saved with the Actor so loading it doesn't regenerate them.
+ *
+ * Segment names are dropped, locations and tangents are stored in single precision, up-vectors as normalized
+ * 16 bits integers and scales as half floats, about 70 bytes per segment.
+ */
+class AEDIFIC_API FAedificSegmentCache
+{
+public:
+	/** Writes the segments of a build into Data, replacing its content. */
+	static void Write(TArray<uint8>& Data, const FAedificSegmentCacheHeader& Header, const TArray<FAedificMeshSegment>& Segments);
+
+	/** Reads segments written by Write. Returns false if Data is empty, truncated or from another cache version. */
+	static bool Read(const TArray<uint8>& Data, FAedificSegmentCacheHeader& OutHeader, TArray<FAedificMeshSegment>& OutSegments);
+};
@@ -0,0 +1,153 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include "AedificSplineTypes.h"
+
+/** Result of a query against a segment index. */
+struct FAedificSegmentHit
+{
+	/** Index of the segment hit, INDEX_NONE if nothing was found. */
+	int32 SegmentIndex;
+
+	/** Point hit, in world space. On the spline for closest point queries, on the segment's cross-section for ray queries. */
+	FVector Location;
+
+	/** Distance along the spline of the point hit. */
+	float SplineDistance;
+
+	/** Distance between the query location and the point hit, or from the start of the ray. */
+	double Distance;
+
+	FAedificSegmentHit()
+	{
+		SegmentIndex =		INDEX_NONE;
+		Location =			FVector::ZeroVector;
+		SplineDistance =	0.f;
+		Distance =			MAX_dbl;
+	}
+
+	/** If the query found a segment. */
+	bool IsValid() const { return SegmentIndex != INDEX_NONE; }
+};
+
+/**
+ * Bounding volume hierarchy over the generated segments of a continuum, in world space.
+ *
+ * Each segment is approximated by a polyline along its curve, swept by the radius of the mesh's cross-section.
+ * The hierarchy splits the segments in spline order, so a rebuild changing some of them only refits the nodes
+ * above them. Snapshots are immutable once built: they can be queried from any thread without touching UObjects.
+ */
+class AEDIFIC_API FAedificSegmentIndex
+{
+public:
+	/** Amount of linear pieces approximating each segment's curve. */
+	static constexpr int32 PiecesPerSegment = 8;
+
+	FAedificSegmentIndex();
+
+	/**
+	 * Builds the index from segments in the Actor's local space.
+	 * CrossSectionRadius is the unscaled radius of the mesh around the spline, scaled by each segment's scale.
+	 */
+	void Build(TConstArrayView<FAedificMeshSegment> Segments, const FTransform& Transform, const float CrossSectionRadius);
+
+	/**
+	 * Updates the segments from FirstSegment to LastSegment included, and refits the nodes above them.
+	 * Segments, transform and radius must otherwise match the ones the index was built from. Returns false, and
+	 * changes nothing, if the amount of segments differs; the index must then be built again.
+	 */
+	bool Refit(TConstArrayView<FAedificMeshSegment> Segments, const int32 FirstSegment, const int32 LastSegment);
+
+	/** Closest point on the spline to Location, within MaxDistance. */
+	bool FindClosestPoint(const FVector& Location, FAedificSegmentHit& OutHit, const double MaxDistance = MAX_dbl) const;
+
+	/** First hit of the line from Start to End against the segments' cross-sections. */
+	bool Raycast(const FVector& Start, const FVector& End, FAedificSegmentHit& OutHit) const;
+
+	/** Appends the indices of the segments whose cross-section is within Radius of Location, in spline order. */
+	void FindSegmentsInRadius(const FVector& Location, const double Radius, TArray<int32>& OutSegments) const;
+
+	/** Batched FindClosestPoint. OutHits must hold as many entries as Locations. */
+	void FindClosestPoints(TConstArrayView<FVector> Locations, TArrayView<FAedificSegmentHit> OutHits, const double MaxDistance = MAX_dbl) const;
+
+	/** Batched Raycast. OutHits must hold as many entries as Starts and Ends. */
+	void Raycasts(TConstArrayView<FVector> Starts, TConstArrayView<FVector> Ends, TArrayView<FAedificSegmentHit> OutHits) const;
+
+	/**
+	 * Batched FindSegmentsInRadius. The segments of query i are OutSegments[OutOffsets[i]] up to OutSegments[OutOffsets[i + 1]] excluded.
+	 */
+	void FindSegmentsInRadius(TConstArrayView<FVector> Locations, const double Radius, TArray<int32>& OutSegments, TArray<int32>& OutOffsets) const;
+
+	/** Amount of indexed segments. */
+	int32 GetNumSegments() const { return NumSegments; }
+
+	/** Transform the index was built with. */
+	const FTransform& GetTransform() const { return Transform; }
+
+	/** Unscaled cross-section radius the index was built with. */
+	float GetCrossSectionRadius() const { return CrossSectionRadius; }
+
+	/** Bounds of every segment, in world space. */
+	FBox GetBounds() const { return Nodes.Num() > 0 ? Nodes[0].Bounds : FBox(ForceInit); }
+
+private:
+
+	/** Node of the hierarchy. The left child of an inner node always directly follows it. */
+	struct FNode
+	{
+		/** Bounds of the segments below the node, cross-section included. */
+		FBox Bounds;
+
+		/** First segment below the node. */
+		int32 FirstSegment;
+
+		/** Amount of segments below the node. */
+		int32 NumSegments;
+
+		/** Index of the right child, INDEX_NONE for leaves. */
+		int32 RightChild;
+	};
+
+	/** Samples a segment into its polyline and bounds. */
+	void UpdateSegment(const int32 Index, const FAedificMeshSegment& Segment);
+
+	/** Builds the subtree of the segments from FirstSegment, returning the index of its root node. */
+	int32 BuildNode(const int32 FirstSegment, const int32 Count);
+
+	/** Recomputes the bounds of the nodes overlapping the segments from FirstSegment to LastSegment included. */
+	void RefitNode(const int32 NodeIndex, const int32 FirstSegment, const int32 LastSegment);
+
+	/** Recomputes the distance along the spline where each segment starts. */
+	void UpdateSplineDistances();
+
+	/** Polyline point of a segment. */
+	const FVector& GetPoint(const int32 SegmentIndex, const int32 PointIndex) const { return Points[SegmentIndex * (PiecesPerSegment + 1) + PointIndex]; }
+
+	/** Transform from the Actor's local space to world space. */
+	FTransform Transform;
+
+	/** Unscaled radius of the mesh's cross-section. */
+	float CrossSectionRadius;
+
+	/** Amount of indexed segments. */
+	int32 NumSegments;
+
+	/** Nodes of the hierarchy, root first. */
+	TArray<FNode> Nodes;
+
+	/** Polyline points of every segment, PiecesPerSegment + 1 per segment. */
+	TArray<FVector> Points;
+
+	/** Distances of the polyline points from the start of their segment, along the curve. */
+	TArray<float> PointOffsets;
+
+	/** Distances along the spline where each segment starts, followed by the end of the last one. */
+	TArray<float> SegmentStartDistances;
+
+	/** Radius of the cross-section of every segment, in world space. */
+	TArray<float> SegmentRadii;
+
+	/** Bounds of every segment, cross-section included. */
+	TArray<FBox> SegmentBounds;
+};
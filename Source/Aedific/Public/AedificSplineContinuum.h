@@ -2,13 +2,28 @@
 
 #pragma once
 
+#include "AedificSplineReplication.h"
+#include "AedificSplineSampler.h"
+#include "AedificSplineTypes.h"
+
 #include <GameFramework/Actor.h>
+#include <Tasks/Task.h>
 
 #include "AedificSplineContinuum.generated.h"
 
 class USplineComponent;
 class USplineMeshComponent;
-struct FAedificMeshSegment;
+class UAedificInstancedSplineMeshComponent;
+class UHierarchicalInstancedStaticMeshComponent;
+class UStaticMeshComponent;
+class UDynamicMeshComponent;
+class UAedificRebuildSubsystem;
+class AAedificContinuumChunk;
+struct FAedificSegmentBuild;
+class FAedificSegmentIndex;
+class FAedificFollowerTrack;
+struct FAedificDynamicMeshSource;
+struct FAedificDynamicMeshBuild;
 
 /**
  * A spline-based construction tool designed for continuous distribution of meshes along
@@ -30,7 +45,11 @@ public:
 
 	//~ Begin of UObject implementation.
 	virtual void BeginDestroy() override;
-	virtual bool CanBeInCluster() const override { return true; }
+	virtual bool CanBeClusterRoot() const override;
+	virtual bool CanBeInCluster() const override;
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+	virtual void PostLoad() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif // WITH_EDITOR
@@ -38,13 +57,143 @@ public:
 
 	//~ Begin of AActor implementation.
 	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Destroyed() override;
 	//~ End of AActor implementation.
 
 	/** Override manual spline values with computed ones. */
-	void ComputeSpline();
+	AEDIFIC_API void ComputeSpline();
+
+	/**
+	 * Requests a rebuild of the meshes along the spline, recycling the present mesh components if any.
+	 * Skipped if none of the inputs changed since the last build, unless forced.
+	 */
+	AEDIFIC_API void RebuildMesh(const bool bForce = false);
+
+	/** Starts the requested rebuild. Called by the rebuild scheduler. */
+	void StartRebuild();
+
+	/**
+	 * Applies queued segments of the finished build until EndTime, or all of them if EndTime is 0.
+	 * Returns true once every segment is applied. Called by the rebuild scheduler.
+	 */
+	bool MaterializeSegments(const double EndTime);
+
+	/**
+	 * Starts a rebuild whose segments are generated on a worker thread even in commandlets, so several Actors can be
+	 * generated in parallel. The spline is computed first if automatic. Returns false if the inputs didn't change
+	 * since the last build and nothing was started, unless forced. FinishBatchRebuild must then be called.
+	 */
+	AEDIFIC_API bool StartBatchRebuild(const bool bForce = false);
+
+	/** Waits for the segments of the rebuild started by StartBatchRebuild, and applies them. */
+	AEDIFIC_API void FinishBatchRebuild();
+
+	/**
+	 * Gives a component to the segments within VirtualizationRadius of the sources, in world space, and returns the ones
+	 * past the hysteresis band to the pool. Components are only acquired until EndTime, if not 0. Called by the rebuild scheduler.
+	 */
+	void UpdateVirtualization(TConstArrayView<FVector> Sources, const double EndTime);
+
+	/** If segment virtualization is active and the next update can't wait for the scheduler's interval. */
+	bool IsVirtualizationUpdateRequested() const { return bVirtualizationActive && bVirtualizationRequested; }
+
+	/** If the meshes don't match the spline, the mesh or the generator anymore, and no rebuild is on the way. */
+	bool IsBuildOutdated() const;
+
+#if WITH_EDITOR
+	/**
+	 * Notifies the Actor or its spline was edited.
+	 * Rebuilds during interactive edits, such as dragging, are coarse previews until a non-interactive edit ends them.
+	 */
+	void NotifyEdited(const bool bInteractive);
+
+	/** If an interactive edit is running. */
+	bool IsInteractivelyEdited() const { return bInteractiveEdit; }
+
+	/** Time of the last interactive edit, in FPlatformTime::Seconds(). */
+	double GetLastInteractiveEditTime() const { return LastInteractiveEditTime; }
+#endif // WITH_EDITOR
+
+	/** If the last requested rebuild is fully generated and applied. */
+	bool IsRebuildComplete() const { return !bRebuildRequested && !PendingBuild.IsValid() && !MaterializingBuild.IsValid(); }
+
+	/** Fraction of the segments of the running rebuild already applied to the components, 1 when complete. */
+	float GetRebuildProgress() const;
+
+	/** Spline the meshes are distributed along. */
+	USplineComponent* GetSplineComponent() const { return SplineComponent; }
+
+	/** Selects the Parallel Transport generator, or the one following the spline's rotations. Takes effect on the next rebuild. */
+	void SetUseParallelTransport(const bool bEnabled) { bUseParallelTransport = bEnabled; }
+
+	/**
+	 * Moves a point of the spline, in the Actor's local space, and requests a rebuild of the segments it affects.
+	 * Meant for continuums edited at runtime: with the dynamic output, only the chunks holding those segments are rebuilt.
+	 */
+	AEDIFIC_API void SetSplinePointLocation(const int32 Index, const FVector& Location);
+
+	/** Appends a point to the spline, in the Actor's local space, and requests a rebuild of the segments it affects. */
+	AEDIFIC_API void AddSplinePoint(const FVector& Location);
+
+	/**
+	 * Runtime edits of the spline replicated to the clients, recorded by SetSplinePointLocation and AddSplinePoint on the server.
+	 * In networked games, points must only be edited on the server, clients regenerate their segments from the replicated points.
+	 */
+	const FAedificSplineEdits& GetSplineEdits() const { return SplineEdits; }
+
+	/** Writes edited points to the spline, and requests a rebuild. Called by FAedificSplineEdits when a client receives them. */
+	AEDIFIC_API void ApplySplineEdits(TConstArrayView<FAedificSplinePointEdit> Edits);
+
+	/** Amount of mesh segments served by an already existing component since the last pool reset. */
+	uint32 GetPoolHits() const { return PoolHits; }
+
+	/** Amount of mesh segments that required a new component allocation since the last pool reset. */
+	uint32 GetPoolMisses() const { return PoolMisses; }
+
+	/** Amount of rebuilds skipped because their inputs matched the last build. */
+	uint32 GetAvoidedRebuilds() const { return AvoidedRebuilds; }
+
+	/** Rebuild totals since the Actor was loaded. */
+	const FAedificContinuumStats& GetContinuumStats() const { return ContinuumStats; }
+
+	/** Amount of spline mesh components owned by the Actor, pooled ones included. */
+	int32 GetNumSplineMeshComponents() const { return GetNumMaterializedSegments() + PooledSplineMeshComponents.Num(); }
+
+	/** Amount of segments currently displayed. */
+	int32 GetNumSegments() const { return MeshSegments.Num(); }
 
-	/** Removes present meshes if any, then rebuilds the meshes along the spline. */
-	void RebuildMesh();
+	/** Amount of segments having a spline mesh component, fewer than GetNumSegments when segments are virtualized. */
+	AEDIFIC_API int32 GetNumMaterializedSegments() const;
+
+	/**
+	 * Groups the Actor and the components it references into a garbage collection cluster rooted at the Actor,
+	 * so they're no longer traversed one by one. Only in game worlds of cooked builds, see Aedific.ComponentClusters.
+	 */
+	AEDIFIC_API void CreateComponentCluster();
+
+	/** Dissolves the cluster of the Actor, before its components change. */
+	AEDIFIC_API void DissolveComponentCluster();
+
+	/** If the Actor currently roots a garbage collection cluster. */
+	bool IsComponentClusterRoot() const { return HasAnyInternalFlags(EInternalObjectFlags::ClusterRoot); }
+
+	/**
+	 * Spatial index of the generated segments, for closest point, ray and radius queries in world space.
+	 * Built on the first call, then kept up to date by every rebuild, refitting only the segments that changed.
+	 * Game thread only, but the returned snapshot is immutable and can be queried from any thread.
+	 */
+	AEDIFIC_API TSharedPtr<const FAedificSegmentIndex> GetSegmentIndex();
+
+	/**
+	 * Track of the generated segments for FAedificSplineFollowers, matching the frames of the visible meshes.
+	 * Built on the first call, then replaced by every rebuild. Game thread only, the returned snapshot is immutable.
+	 */
+	AEDIFIC_API TSharedPtr<const FAedificFollowerTrack> GetFollowerTrack();
+
+	/** Stable hash of every input affecting the generated meshes. Never 0. */
+	AEDIFIC_API uint64 ComputeInputHash() const;
 
 protected:
 
@@ -96,38 +245,341 @@ protected:
 	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (EditCondition = bAutoRebuildMesh))
 	uint8 bUseParallelTransport : 1;
 
+	/**
+	 * If segment boundaries follow the curvature instead of tiling the mesh at its length.
+	 * Straight runs get fewer, stretched segments, and tight curves get shorter ones.
+	 */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (EditCondition = "bAutoRebuildMesh && OutputMode != EAedificMeshOutput::Scattered"))
+	uint8 bAdaptiveSegmentation : 1;
+
+	/** Maximum distance between the spline and the straight line joining a segment's ends. */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (ClampMin = 0.1f, UIMin = 0.1f, Units = cm, EditCondition = bAdaptiveSegmentation, EditConditionHides))
+	float MaxChordDeviation;
+
+	/** Maximum roll of the spline across a segment. Ignored by Parallel Transport, whose frames never twist. */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (ClampMin = 0.f, UIMin = 0.f, ClampMax = 180.f, UIMax = 180.f, Units = deg, EditCondition = bAdaptiveSegmentation, EditConditionHides))
+	float MaxSegmentTwist;
+
+	/** Maximum length of a segment, as a multiple of the mesh length. */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (ClampMin = 1.f, UIMin = 1.f, UIMax = 8.f, EditCondition = bAdaptiveSegmentation, EditConditionHides))
+	float MaxSegmentStretch;
+
+	/** How the generated segments are turned into geometry. */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (EditCondition = bAutoRebuildMesh))
+	EAedificMeshOutput OutputMode;
+
+	/** Maximum amount of segments baked into a single static mesh. */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (ClampMin = 1, UIMin = 1, EditCondition = "OutputMode == EAedificMeshOutput::Baked", EditConditionHides))
+	int32 BakeChunkSize;
+
+	/** Amount of segments deformed into each dynamic mesh. Smaller chunks make edits cheaper, larger ones draw faster. */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (ClampMin = 1, UIMin = 1, EditCondition = "OutputMode == EAedificMeshOutput::Dynamic", EditConditionHides))
+	int32 DynamicChunkSize;
+
+	/** Distance between two scattered instances. If 0, the mesh's length is used. */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (ClampMin = 0.f, UIMin = 0.f, Units = cm, EditCondition = "OutputMode == EAedificMeshOutput::Scattered", EditConditionHides))
+	float ScatterSpacing;
+
+	/**
+	 * If, in game worlds, only the segments near a viewer or a player get a spline mesh component. The others are only kept
+	 * as records, so components and scene primitives scale with the part of the continuum around the players.
+	 */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (EditCondition = "OutputMode == EAedificMeshOutput::SplineMeshes", EditConditionHides))
+	uint8 bVirtualizeSegments : 1;
+
+	/** Distance from the viewers and players within which segments get a component. */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (ClampMin = 100.f, UIMin = 100.f, Units = cm, EditCondition = "OutputMode == EAedificMeshOutput::SplineMeshes && bVirtualizeSegments", EditConditionHides))
+	float VirtualizationRadius;
+
+	/** Extra distance past VirtualizationRadius before a segment's component returns to the pool, so it doesn't go back and forth. */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (ClampMin = 0.f, UIMin = 0.f, Units = cm, EditCondition = "OutputMode == EAedificMeshOutput::SplineMeshes && bVirtualizeSegments", EditConditionHides))
+	float VirtualizationHysteresis;
+
+#if WITH_EDITORONLY_DATA
+	/** Content folder where baked meshes are saved as assets. If empty, they are stored within the level. */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (ContentDir, EditCondition = "OutputMode == EAedificMeshOutput::Baked", EditConditionHides))
+	FDirectoryPath BakedMeshDirectory;
+
+	/**
+	 * If the baked meshes are split along a grid matching the World Partition runtime grid, each chunk baked into its own
+	 * spatially loaded actor, so only the chunks near the player are streamed in and each one gets its own HLOD proxy.
+	 */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (EditCondition = "OutputMode == EAedificMeshOutput::Baked", EditConditionHides))
+	uint8 bBakeStreamingChunks : 1;
+
+	/** Size of the streaming chunks grid cells, should match the cell size of the World Partition runtime grid. */
+	UPROPERTY(EditInstanceOnly, Category = "Aedific|Mesh", Meta = (ClampMin = 100.f, UIMin = 100.f, Units = cm, EditCondition = "OutputMode == EAedificMeshOutput::Baked && bBakeStreamingChunks", EditConditionHides))
+	float StreamingCellSize;
+
+	/** Actors holding the baked streaming chunks. Soft references, so World Partition doesn't stream them along with this Actor. */
+	UPROPERTY()
+	TArray<TSoftObjectPtr<AAedificContinuumChunk>> StreamingChunks;
+#endif // WITH_EDITORONLY_DATA
+
 	/** Compute tangents using a Linear-Scaled method. */
 	void ComputeTangents(const int32 SplinePointsNum, const bool bClosed);
 
 	/** Transforms the Spline's rotations into its Up-Vectors. */
 	void ComputeUpVectors(const int32 SplinePointsNum);
 
-	/** Create a Mesh along the Spline. */
-	void GenerateMesh(const float MeshLength, const float SplineLength, const int32 LoopSize);
+	/**
+	 * Generates the mesh segments from a snapshot of the Spline on the worker threads, superseding any build still running.
+	 * Only regenerates the segments overlapping the dirty range.
+	 */
+	void LaunchSegmentBuild(const float MeshLength, const float SplineLength, const int32 LoopSize, const FAedificDirtyRange& DirtyRange, const bool bPreview);
 
-	/**  Applies Frenet-like parallel transport frame builder to ensure smooth rotation along loops. */
-	void GenerateMeshParallelTransport(const float MeshLength, const float SplineLength, const int32 LoopSize);
+	/**
+	 * Queues the segments of a finished build to be applied to the components, unless a newer build superseded it.
+	 * Segments nearest to the edit, or to the viewer, are queued first.
+	 */
+	void ApplySegmentBuild(const TSharedRef<FAedificSegmentBuild>& Build);
 
-	/** Create a single segment of the mesh from the Spline. */
-	void CreateSegment(const FAedificMeshSegment& Segment);
+	/** Location the materialization queue is ordered around, in local space. Returns false if there's none. */
+	bool GetMaterializationFocus(const FAedificSegmentBuild& Build, FVector& OutLocation) const;
 
-	/** Removes and deletes all existing mesh segments. */
+	/** Cancels the build still running or being applied, if any, discarding its results. */
+	void CancelPendingBuild();
+
+	/** Removes unused outputs, releases the left-over segments, updates the baked or instanced output, and remembers the build's inputs. */
+	void FinishRebuild(const int32 LoopSize, const FAedificDirtyRange& DirtyRange, FAedificMeshBuildState&& State, const bool bPreview);
+
+	/** Segmentation settings of the next build. */
+	FAedificSegmentation GetSegmentation() const;
+
+	/** Compares the Spline against the last build to find the distance range that must be regenerated. */
+	FAedificDirtyRange FindDirtyRange(const float MeshLength, const float SplineLength) const;
+
+	/** Snapshots the generator inputs of a build, along with the Parallel Transport frames of the last one. */
+	FAedificMeshBuildState CaptureBuildState(const float MeshLength, const float SplineLength) const;
+
+	/**
+	 * Create a single segment of the mesh from the Spline, re-targeting the component at Index if there's one.
+	 * Nothing is re-applied if that component already displays an identical segment.
+	 */
+	void CreateSegment(const int32 Index, const FAedificMeshSegment& Segment);
+
+	/** Applies the segment's parameters to a spline mesh component. */
+	void ApplySegment(USplineMeshComponent* MeshSegment, const FAedificMeshSegment& Segment);
+
+	/** Returns all mesh segments from Index onwards to the component pool. */
+	void ReleaseSegments(const int32 Index);
+
+	/** Removes and deletes all existing mesh segments, including the pooled and baked ones. */
 	void EmptyMesh();
 
+	/** Bakes the generated segments into static meshes, replacing the spline mesh components. */
+	void BakeMesh();
+
+	/** Removes and deletes the baked static mesh components. Streaming chunks are left in the level. */
+	void EmptyBakedMesh();
+
+#if WITH_EDITOR
+	/**
+	 * Splits the segments into contiguous ranges baked together, as (first segment, amount of segments) pairs.
+	 * Streaming chunks also break wherever the segments cross into another grid cell.
+	 */
+	TArray<FIntPoint> ComputeBakeChunks() const;
+
+	/** If the baked meshes or streaming chunks match the chunk ranges. */
+	bool AreBakedChunksValid(TConstArrayView<FIntPoint> Chunks) const;
+
+	/** Returns the actor holding the streaming chunk, spawning it if needed. */
+	AAedificContinuumChunk* GetStreamingChunk(const int32 Chunk);
+
+	/** Deletes the streaming chunks from NumChunks onwards. */
+	void TruncateStreamingChunks(const int32 NumChunks);
+#endif // WITH_EDITOR
+
+	/** Returns the instanced spline mesh component, creating it if needed. */
+	UAedificInstancedSplineMeshComponent* GetInstancedMeshComponent();
+
+	/** Removes the instances left over from a longer previous build, and flushes the updated records. */
+	void UpdateInstancedMesh(const int32 LoopSize);
+
+	/** Removes and deletes the instanced spline mesh component. */
+	void EmptyInstancedMesh();
+
+	/** Returns the dynamic mesh component of a chunk, creating it if needed. */
+	UDynamicMeshComponent* GetDynamicMeshComponent(const int32 Chunk);
+
+	/** Removes the chunks left over from a longer previous build, and rebuilds the ones whose segments changed on the worker threads. */
+	void UpdateDynamicMesh();
+
+	/** Applies the chunks of a finished dynamic mesh build to their components, unless a newer build superseded it. */
+	void ApplyDynamicMeshBuild(const TSharedRef<FAedificDynamicMeshBuild>& Build);
+
+	/** Removes and deletes the dynamic mesh components. */
+	void EmptyDynamicMesh();
+
+	/** Places undeformed instances of the mesh at a fixed spacing along the Spline, replacing the spline mesh components. */
+	void ScatterMesh(const float MeshLength, const float SplineLength);
+
+	/** Returns the scattered instances component, creating it if needed. */
+	UHierarchicalInstancedStaticMeshComponent* GetScatteredMeshComponent();
+
+	/** Removes and deletes the scattered instances component. */
+	void EmptyScatteredMesh();
+
+	/** Removes the baked, instanced, scattered and dynamic outputs not matching the current output mode. */
+	void EmptyUnusedOutputs();
+
 	/** Update the materials of the mesh if an MaterialOverride is set. */
 	void UpdateMaterial();
 
 private:
 
+	/** Rebuild scheduler of the Actor's world, if any. */
+	UAedificRebuildSubsystem* GetRebuildSubsystem() const;
+
+	/** Notifies the rebuild scheduler the requested rebuild is done. */
+	void NotifyRebuildFinished();
+
+	/** Builds or refits the segment index to match MeshSegments and the Actor's transform. */
+	void UpdateSegmentIndex();
+
+	/** Replaces the follower track with one matching MeshSegments and the Actor's transform. */
+	void UpdateFollowerTrack();
+
+	/** Updates the spline after its points were edited at runtime, and requests a rebuild. */
+	void NotifySplinePointsEdited();
+
+	/** Records a point edited on the server so it's replicated, quantizing it the way clients receive it. */
+	void RecordSplineEdit(const int32 PointIndex);
+
+	/** Takes a component from the pool, or creates a new one if the pool is empty. */
+	USplineMeshComponent* AcquireSplineMeshComponent(const FAedificMeshSegment& Segment);
+
+	/** Destroys every component waiting in the pool. */
+	void DestroyPooledComponents();
+
+	/** Gives the segment at Index a component from the pool, and applies the segment to it. */
+	void AcquireSegmentComponent(const int32 Index);
+
+	/** Returns the component of the segment at Index to the pool, if it has one. */
+	void ReleaseSegment(const int32 Index);
+
+	/** Destroys the pooled components past MaxPooled. */
+	void TrimPool(const int32 MaxPooled);
+
 #if WITH_EDITORONLY_DATA
 	/** Sprite to show the Actor's sprite in Editor. */
 	TObjectPtr<UBillboardComponent> EditorSprite;
 #endif // WITH_EDITORONLY_DATA
 
-	/** Keeps track if there's already an mesh rebuild request ongoing so we don't rebuild the mesh multiple times on the same frame. */
+	/** Keeps track if a mesh rebuild is queued in the rebuild scheduler and not started yet. */
 	uint8 bRebuildRequested : 1;
 
+	/** If the displayed segments come from a coarse preview build. */
+	uint8 bPreviewBuilt : 1;
+
+	/** If the running rebuild was started by StartBatchRebuild, and waits for FinishBatchRebuild to be applied. */
+	uint8 bBatchRebuild : 1;
+
+	/** If only the segments near the viewers have a component, registered with the rebuild scheduler between BeginPlay and EndPlay. */
+	uint8 bVirtualizationActive : 1;
+
+	/** If segments changed since the last virtualization update, and must get a component if they're in range. */
+	uint8 bVirtualizationRequested : 1;
+
+	/** Segment generation of the batch rebuild. */
+	UE::Tasks::FTask BatchBuildTask;
+
+#if WITH_EDITOR
+	/** If an interactive edit is running, rebuilds are then coarse previews. */
+	uint8 bInteractiveEdit : 1;
+
+	/** Time of the last interactive edit. */
+	double LastInteractiveEditTime;
+#endif // WITH_EDITOR
+
 	/** Container for the generated meshes. */
 	UPROPERTY()
 	TArray<TObjectPtr<USplineMeshComponent>> SplineMeshComponents;
+
+	/** Spline points edited at runtime, replicated as per-point deltas. Never saved, the level holds the points as placed. */
+	UPROPERTY(Replicated, Transient)
+	FAedificSplineEdits SplineEdits;
+
+	/** Segments currently displayed by the generated meshes, matching SplineMeshComponents by index. */
+	TArray<FAedificMeshSegment> MeshSegments;
+
+	/** Inputs of the last build, used for partial regeneration. */
+	FAedificMeshBuildState BuildState;
+
+	/** MeshSegments of an up to date build in the compact form of FAedificSegmentCache, written on save and consumed on load. */
+	UPROPERTY()
+	TArray<uint8> SegmentCache;
+
+	/** Arc-length sampler of the spline, built at the start of each rebuild. */
+	FAedificSplineSampler SplineSampler;
+
+	/** Segment build running on the worker threads, if any. */
+	TSharedPtr<FAedificSegmentBuild> PendingBuild;
+
+	/** Spatial index of MeshSegments, once requested by GetSegmentIndex. */
+	TSharedPtr<FAedificSegmentIndex> SegmentIndex;
+
+	/** Follower track of MeshSegments, once requested by GetFollowerTrack. */
+	TSharedPtr<const FAedificFollowerTrack> FollowerTrack;
+
+	/** Range of MeshSegments changed since SegmentIndex was last updated, empty if First is greater than Last. */
+	int32 FirstUnindexedSegment;
+	int32 LastUnindexedSegment;
+
+	/** Finished segment build being applied to the components, if any. */
+	TSharedPtr<FAedificSegmentBuild> MaterializingBuild;
+
+	/** Indices of the segments of MaterializingBuild, in the order they're applied. */
+	TArray<int32> MaterializationQueue;
+
+	/** Position of the next segment to apply in MaterializationQueue. */
+	int32 NextMaterializedSegment;
+
+	/** Hidden components released by previous rebuilds, ready to be re-targeted by the next ones. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USplineMeshComponent>> PooledSplineMeshComponents;
+
+	/** Amount of segments served by recycled components. */
+	uint32 PoolHits;
+
+	/** Amount of segments that required a new component. */
+	uint32 PoolMisses;
+
+	/** Amount of rebuilds skipped because their inputs matched the last build. */
+	uint32 AvoidedRebuilds;
+
+	/** Rebuild totals since the Actor was loaded. */
+	FAedificContinuumStats ContinuumStats;
+
+	/** Components displaying the baked meshes, one per chunk. */
+	UPROPERTY()
+	TArray<TObjectPtr<UStaticMeshComponent>> BakedMeshComponents;
+
+	/** If the segments changed since the last bake. */
+	uint8 bBakeRequired : 1;
+
+	/** Component rendering every segment as an instance, when using the instanced output. */
+	UPROPERTY()
+	TObjectPtr<UAedificInstancedSplineMeshComponent> InstancedMeshComponent;
+
+	/** Component holding the undeformed instances, when using the scattered output. */
+	UPROPERTY()
+	TObjectPtr<UHierarchicalInstancedStaticMeshComponent> ScatteredMeshComponent;
+
+	/** Components displaying the dynamic meshes, one per chunk, when using the dynamic output. */
+	UPROPERTY()
+	TArray<TObjectPtr<UDynamicMeshComponent>> DynamicMeshComponents;
+
+	/** Geometry the dynamic meshes are deformed from, read from the mesh on the first dynamic rebuild. */
+	TSharedPtr<const FAedificDynamicMeshSource> DynamicMeshSource;
+
+	/** Mesh and chunk size the dynamic meshes were built with. Every chunk is rebuilt when either changes. */
+	TWeakObjectPtr<const UStaticMesh> DynamicMeshSourceMesh;
+	int32 DynamicMeshChunkSize;
+
+	/** Chunks whose segments changed since they were last applied. */
+	TSet<int32> DirtyDynamicChunks;
+
+	/** Generation of the last launched dynamic mesh build. */
+	uint32 DynamicMeshGeneration;
 };
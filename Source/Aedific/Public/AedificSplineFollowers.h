@@ -0,0 +1,154 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include "AedificRotationMinimizingFrames.h"
+#include "AedificSplineTypes.h"
+
+#include <Tasks/Task.h>
+
+/**
+ * Immutable copy of a continuum's generated segments, for followers to move along.
+ *
+ * Segments are evaluated the way spline mesh components deform their mesh, so followers line up with the visible
+ * geometry and its frames, Parallel Transport ones included. Each segment holds an arc-length table, so distances
+ * along the track are mapped to curve parameters without searching the spline's reparam table.
+ */
+class AEDIFIC_API FAedificFollowerTrack
+{
+public:
+	/** Amount of arc-length table entries per segment. */
+	static constexpr int32 StepsPerSegment = 8;
+
+	FAedificFollowerTrack();
+
+	/** Builds the track from segments in the Actor's local space. */
+	void Build(TConstArrayView<FAedificMeshSegment> Segments, const FTransform& Transform, const bool bClosedLoop);
+
+	/** If the track has at least one segment. */
+	bool IsValid() const { return NumSegments > 0; }
+
+	/** Total length of the track, in the Actor's space. */
+	float GetLength() const { return TableDistances.Num() > 0 ? TableDistances.Last() : 0.f; }
+
+	/** If followers wrap around at the end of the track. */
+	bool IsClosedLoop() const { return bClosedLoop; }
+
+	/** Transform from the Actor's local space to world space. */
+	const FTransform& GetTransform() const { return Transform; }
+
+	/** Arc-length table interval holding a distance, searched from scratch. */
+	int32 FindEntry(const float Distance) const;
+
+	/** Arc-length table interval holding a distance, stepping from a previous one. Amortized O(1) for small moves. */
+	int32 AdvanceEntry(const int32 Entry, const float Distance) const;
+
+	/** Segment and curve parameter at a distance, within the table interval returned by FindEntry or AdvanceEntry. */
+	void GetSegmentAlpha(const int32 Entry, const float Distance, int32& OutSegment, float& OutAlpha) const;
+
+	/** Location, direction and up-vector of a segment at a curve parameter, in local space. */
+	void Evaluate(const int32 Segment, const float Alpha, FVector3f& OutLocation, FVector3f& OutDirection, FVector3f& OutUp) const;
+
+private:
+	/** Transform from the Actor's local space to world space. */
+	FTransform Transform;
+
+	/** If the last segment ends where the first one starts. */
+	bool bClosedLoop;
+
+	/** Amount of segments. */
+	int32 NumSegments;
+
+	/** Curves of the segments. */
+	FAedificVectorStreams StartLocations;
+	FAedificVectorStreams StartTangents;
+	FAedificVectorStreams EndLocations;
+	FAedificVectorStreams EndTangents;
+
+	/** Reference up-vectors of the segments, and their rolls in radians. */
+	FAedificVectorStreams UpVectors;
+	TArray<float> StartRolls;
+	TArray<float> EndRolls;
+
+	/** Distances along the track at regular curve parameters, StepsPerSegment per segment, followed by the total length. */
+	TArray<float> TableDistances;
+};
+
+/**
+ * Cursors of agents moving along a continuum, updated together.
+ *
+ * Each follower remembers the arc-length table interval it stands in, so small steps only move it to a neighbor.
+ * Followers are stored as parallel arrays and updated in successive passes over all of them: moving the cursors,
+ * evaluating the curves, then building the frames.
+ */
+class AEDIFIC_API FAedificSplineFollowers
+{
+public:
+	FAedificSplineFollowers();
+
+	/** Replaces the track the followers move along. Cursors are searched again on the next update. */
+	void SetTrack(const TSharedPtr<const FAedificFollowerTrack>& InTrack);
+
+	/** Track the followers move along. */
+	const TSharedPtr<const FAedificFollowerTrack>& GetTrack() const { return Track; }
+
+	/** Adds a follower, returning its index. */
+	int32 Add(const float Distance, const float Speed = 0.f);
+
+	/** Removes a follower. The last follower takes its index. */
+	void RemoveAtSwap(const int32 Index);
+
+	/** Amount of followers. */
+	int32 Num() const { return Distances.Num(); }
+
+	/** Moves a follower to a distance along the track. */
+	void SetDistance(const int32 Index, const float Distance) { Distances[Index] = Distance; }
+
+	/** Speed of a follower along the track, in units per second. Negative speeds move backward. */
+	void SetSpeed(const int32 Index, const float Speed) { Speeds[Index] = Speed; }
+
+	float GetDistance(const int32 Index) const { return Distances[Index]; }
+	float GetSpeed(const int32 Index) const { return Speeds[Index]; }
+
+	/** World location of a follower, as of the last update. */
+	const FVector& GetLocation(const int32 Index) const { return Locations[Index]; }
+
+	/** World rotation of a follower, X forward and Z up, as of the last update. */
+	const FQuat& GetRotation(const int32 Index) const { return Rotations[Index]; }
+
+	/** Moves every follower by its speed, and evaluates their locations and rotations. */
+	void Update(const float DeltaTime);
+
+	/**
+	 * Runs Update on a task thread. The followers must not be accessed until the returned task completes.
+	 * The track is shared, so the continuum can rebuild in the meantime.
+	 */
+	UE::Tasks::FTask UpdateAsync(const float DeltaTime);
+
+private:
+	/** Track the followers move along. */
+	TSharedPtr<const FAedificFollowerTrack> Track;
+
+	/** If the cursors belong to a previous track. */
+	bool bTrackChanged;
+
+	/** Distances along the track, and speeds. */
+	TArray<float> Distances;
+	TArray<float> Speeds;
+
+	/** Arc-length table intervals of the followers. */
+	TArray<int32> Entries;
+
+	/** Segments and curve parameters of the followers, for the evaluation passes. */
+	TArray<int32> Segments;
+	TArray<float> Alphas;
+
+	/** Local locations, directions and up-vectors of the followers, for the frame pass. */
+	FAedificVectorStreams LocalLocations;
+	FAedificVectorStreams LocalDirections;
+	FAedificVectorStreams LocalUps;
+
+	/** Evaluated locations and rotations. */
+	TArray<FVector> Locations;
+	TArray<FQuat> Rotations;
+};
@@ -0,0 +1,36 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+/**
+ * Spline math shared by the continuum and its generators, working on plain point, tangent and frame arrays
+ * so it can be profiled and validated without a spline component or a world.
+ */
+class AEDIFIC_API FAedificSplineMath
+{
+public:
+	/**
+	 * Computes linear-scaled tangents: interior points, and every point of a closed loop, get a tangent along the
+	 * direction between their neighbors, scaled by the distance to each neighbor. Endpoints of an open spline get one-sided tangents.
+	 * Scale is 0 for constant interpolation and 1 for smooth curves.
+	 */
+	static void ComputeTangents(TConstArrayView<FVector> Locations, const bool bClosed, const float Scale, TArrayView<FVector> OutArriveTangents, TArrayView<FVector> OutLeaveTangents);
+
+	/** Roll of the frame (Direction, Right, Up) relative to Rotation, in degrees. */
+	static float GetRelativeRoll(const FQuat& Rotation, const FVector& Direction, const FVector& Right, const FVector& Up);
+
+	/** Roll around Tangent bringing ReferenceUp, projected perpendicular to Tangent, onto Normal, in degrees. */
+	static float CalculateRollInDegrees(const FVector& Tangent, const FVector& Normal, const FVector& ReferenceUp);
+
+	/** Angle the up-vector rolls around the spline between two frames, ignoring the change of direction, in degrees. */
+	static float GetTwistDegrees(const FVector& StartDirection, const FVector& StartUp, const FVector& EndDirection, const FVector& EndUp);
+
+	/**
+	 * Computes the reference up-vector and the rolls of a segment spanning two rotation-minimizing frames.
+	 * The up-vector averages both normals, and each roll brings it onto its frame's normal.
+	 */
+	static void ComputeFrameSegmentRolls(const FVector& StartTangent, const FVector& StartNormal, const FVector& EndTangent, const FVector& EndNormal,
+		FVector& OutUpVector, float& OutStartRollDegrees, float& OutEndRollDegrees);
+};
@@ -0,0 +1,134 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include <Net/Serialization/FastArraySerializer.h>
+
+#include "AedificSplineReplication.generated.h"
+
+class AAedificSplineContinuum;
+class USplineComponent;
+
+/**
+ * Generator inputs of a spline point edited at runtime, quantized as they're replicated: locations and tangents
+ * to a millimeter, rotations to 16 bits per axis, scales to a hundredth.
+ */
+USTRUCT()
+struct AEDIFIC_API FAedificSplinePointEdit : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	/** Index of the point in the spline. */
+	UPROPERTY()
+	int32 PointIndex;
+
+	/** Sequence number of the edit that last changed the point. */
+	UPROPERTY()
+	uint32 Sequence;
+
+	/** Point, in the Actor's local space. */
+	UPROPERTY()
+	FVector Location;
+
+	UPROPERTY()
+	FVector ArriveTangent;
+
+	UPROPERTY()
+	FVector LeaveTangent;
+
+	UPROPERTY()
+	FRotator Rotation;
+
+	UPROPERTY()
+	FVector Scale;
+
+	/** ESplinePointType of the point. */
+	UPROPERTY()
+	uint8 PointType;
+
+	/**
+	 * If the tangents are replicated, only for custom tangent points when the continuum doesn't compute them.
+	 * Other tangents are left out, every machine computes them the same way.
+	 */
+	UPROPERTY()
+	bool bHasTangents;
+
+	FAedificSplinePointEdit();
+
+	/** Reads a point from the updated spline, and quantizes it the way it's replicated. */
+	void Capture(const USplineComponent* Spline, const int32 Index, const bool bWithTangents);
+
+	/** Writes the point to the spline, without updating it. */
+	void Apply(USplineComponent* Spline) const;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FAedificSplinePointEdit> : public TStructOpsTypeTraitsBase2<FAedificSplinePointEdit>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/**
+ * Spline points of a continuum edited at runtime, replicated as per-point deltas: a client only receives the points
+ * changed since its last update. Points never edited are the ones every machine loaded with the level, and clients
+ * regenerate the segments from the points themselves.
+ */
+USTRUCT()
+struct AEDIFIC_API FAedificSplineEdits : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	/** Edited points, in the order they were first edited. */
+	UPROPERTY()
+	TArray<FAedificSplinePointEdit> Items;
+
+	/** Continuum the edits belong to, notified when clients receive some. */
+	AAedificSplineContinuum* Owner;
+
+	FAedificSplineEdits();
+
+	/** Records a point edited on the server, quantized, and marks it to be replicated. Returns its edit. */
+	const FAedificSplinePointEdit& RecordPoint(const USplineComponent* Spline, const int32 PointIndex, const bool bWithTangents);
+
+	/** Edit of a point, nullptr if it was never edited. */
+	const FAedificSplinePointEdit* FindPoint(const int32 PointIndex) const;
+
+	/** Sequence number of the last edit recorded on the server, or received on a client. */
+	uint32 GetSequence() const { return Sequence; }
+
+	//~ Begin of FFastArraySerializer implementation.
+	void PostReplicatedAdd(const TArrayView<int32>& AddedIndices, int32 FinalSize);
+	void PostReplicatedChange(const TArrayView<int32>& ChangedIndices, int32 FinalSize);
+	void PostReplicatedReceive(const FFastArraySerializer::FPostReplicatedReceiveParameters& Parameters);
+	//~ End of FFastArraySerializer implementation.
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FAedificSplinePointEdit, FAedificSplineEdits>(Items, DeltaParms, *this);
+	}
+
+private:
+
+	/** Sequence number of the last edit. */
+	uint32 Sequence;
+
+	/** Index in Items of every edited point. */
+	TMap<int32, int32> PointItems;
+
+	/** Items received since the last PostReplicatedReceive. */
+	TArray<int32> ReceivedItems;
+};
+
+template<>
+struct TStructOpsTypeTraits<FAedificSplineEdits> : public TStructOpsTypeTraitsBase2<FAedificSplineEdits>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -0,0 +1,102 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include <Math/InterpCurve.h>
+
+class USplineComponent;
+
+/** Spline state at a given distance, in the spline's local space. */
+struct FAedificSplineSample
+{
+	/** Distance along the spline. */
+	float Distance;
+
+	/** Spline input key matching the distance. */
+	float InputKey;
+
+	/** Location on the spline. */
+	FVector Location;
+
+	/** Tangent of the spline, the derivative of its location. */
+	FVector Tangent;
+
+	/** Rotation of the spline, with X along the tangent and Z along the up-vector. */
+	FQuat Rotation;
+
+	/** Scale of the spline. */
+	FVector Scale;
+
+	FAedificSplineSample()
+	{
+		Distance =	0.f;
+		InputKey =	0.f;
+		Location =	FVector::ZeroVector;
+		Tangent =	FVector::ZeroVector;
+		Rotation =	FQuat::Identity;
+		Scale =		FVector::OneVector;
+	}
+
+	FVector GetDirection() const { return Tangent.GetSafeNormal(); }
+	FVector GetRightVector() const { return Rotation.GetAxisY(); }
+	FVector GetUpVector() const { return Rotation.GetAxisZ(); }
+};
+
+/**
+ * Evaluates a spline at many distances at once, from an immutable copy of its curves.
+ *
+ * Keeps its own arc-length table, finer than the spline component's reparam table and refined with a Newton step,
+ * and evaluates sorted distances in a single monotonic sweep instead of searching the table and curves on every call.
+ * Results match the spline component's Get*AtDistanceAlongSpline() in local space.
+ */
+class AEDIFIC_API FAedificSplineSampler
+{
+public:
+	/** Amount of arc-length table entries per spline segment. */
+	static constexpr int32 DefaultStepsPerSegment = 32;
+
+	FAedificSplineSampler();
+
+	/** Copies the spline's curves and builds the arc-length table. */
+	void Build(const USplineComponent* Spline, const int32 StepsPerSegment = DefaultStepsPerSegment);
+
+	/** If the sampler was built from a spline with at least one segment. */
+	bool IsValid() const { return NumSegments > 0; }
+
+	/** Total length of the spline. */
+	float GetLength() const { return TableDistances.Num() > 0 ? TableDistances.Last() : 0.f; }
+
+	/** If the spline is a closed loop. */
+	bool IsClosedLoop() const { return Position.bIsLooped; }
+
+	/** Distance along the spline at one of its points. */
+	float GetDistanceAtSplinePoint(const int32 PointIndex) const;
+
+	/** Samples the spline at a single distance. */
+	FAedificSplineSample SampleAtDistance(const float Distance) const;
+
+	/** Samples the spline at distances sorted in ascending order, in a single sweep. */
+	void SampleAtDistances(TConstArrayView<float> SortedDistances, TArrayView<FAedificSplineSample> OutSamples) const;
+
+private:
+	/** Samples the spline at a distance, starting the table search from Cursor and leaving it on the distance's entry. */
+	FAedificSplineSample SampleAtDistance(const float Distance, int32& Cursor) const;
+
+	/** Copied curves of the spline. */
+	FInterpCurveVector Position;
+	FInterpCurveQuat Rotation;
+	FInterpCurveVector Scale;
+
+	/** Up-vector the spline rotations are relative to. */
+	FVector DefaultUpVector;
+
+	/** Amount of curve segments, closing segment included. */
+	int32 NumSegments;
+
+	/** Amount of arc-length table entries per segment. */
+	int32 StepsPerSegment;
+
+	/** Arc-length table, as distances and their matching input keys. */
+	TArray<float> TableDistances;
+	TArray<float> TableKeys;
+};
@@ -2,10 +2,39 @@
 
 #pragma once
 
+#include "AedificRotationMinimizingFrames.h"
+
+#include <Components/SplineComponent.h>
 #include <Components/SplineMeshComponent.h>
 
 #include "AedificSplineTypes.generated.h"
 
+/** How the generated mesh segments are turned into geometry. */
+UENUM()
+enum class EAedificMeshOutput : uint8
+{
+	/** One spline mesh component per segment, deformed on the GPU. */
+	SplineMeshes,
+
+	/** Segments deformed on the CPU and baked into one or a few static meshes. Requires the editor. */
+	Baked,
+
+	/**
+	 * Every segment drawn as an instance of the mesh, deformed by its material.
+	 * The material must deform the mesh with "/Plugin/Aedific/AedificInstancedSplineMesh.ush".
+	 */
+	Instanced,
+
+	/** Undeformed instances of the mesh placed at a fixed spacing, for posts, poles and other repeated props. */
+	Scattered,
+
+	/**
+	 * Segments deformed on the CPU into movable dynamic meshes, one per chunk of segments, for continuums edited at runtime.
+	 * Only the chunks whose segments changed are rebuilt. The mesh must allow CPU access in cooked builds.
+	 */
+	Dynamic,
+};
+
 USTRUCT()
 struct FAedificMeshSegment
 {
@@ -54,4 +83,168 @@ struct FAedificMeshSegment
 		StartScale =		FVector2D::UnitVector;
 		EndScale =			FVector2D::UnitVector;
 	}
+
+	/** If both segments produce the same mesh, ignoring their names. */
+	bool Equals(const FAedificMeshSegment& Other, const float Tolerance = KINDA_SMALL_NUMBER) const
+	{
+		return StartLocation.Equals(Other.StartLocation, Tolerance)
+			&& EndLocation.Equals(Other.EndLocation, Tolerance)
+			&& StartTangent.Equals(Other.StartTangent, Tolerance)
+			&& EndTangent.Equals(Other.EndTangent, Tolerance)
+			&& UpVector.Equals(Other.UpVector, Tolerance)
+			&& FMath::IsNearlyEqual(StartRollDegrees, Other.StartRollDegrees, Tolerance)
+			&& FMath::IsNearlyEqual(EndRollDegrees, Other.EndRollDegrees, Tolerance)
+			&& StartScale.Equals(Other.StartScale, Tolerance)
+			&& EndScale.Equals(Other.EndScale, Tolerance);
+	}
+};
+
+/** Rebuild totals of a continuum since it was loaded. */
+struct FAedificContinuumStats
+{
+	/** Amount of rebuilds started. */
+	uint32 NumRebuilds;
+
+	/** Amount of segments applied to the outputs. */
+	uint32 NumSegmentsApplied;
+
+	/** Amount of spline mesh components created and destroyed. */
+	uint32 NumComponentsCreated;
+	uint32 NumComponentsDestroyed;
+
+	/** Time spent on the game thread starting rebuilds and applying their segments, in seconds. */
+	double GameThreadTime;
+
+	/** Time spent generating segments on the worker threads, in seconds. */
+	double WorkerTime;
+
+	/** Longest time between a rebuild request and its completion, in seconds. */
+	double MaxLatency;
+
+	FAedificContinuumStats()
+	{
+		NumRebuilds =				0;
+		NumSegmentsApplied =		0;
+		NumComponentsCreated =		0;
+		NumComponentsDestroyed =	0;
+		GameThreadTime =			0.0;
+		WorkerTime =				0.0;
+		MaxLatency =				0.0;
+	}
+
+	/** Total generation time, on any thread. */
+	double GetTotalTime() const { return GameThreadTime + WorkerTime; }
+};
+
+/** Distance range along the spline that changed since the last mesh build. */
+struct FAedificDirtyRange
+{
+	/** If the whole spline must be regenerated, ignoring the range. */
+	bool bFullRebuild;
+
+	/** Distance along the spline where the changes start. */
+	float StartDistance;
+
+	/** Distance along the spline where the changes end. */
+	float EndDistance;
+
+	/** Difference between the current spline length and the one of the last build. */
+	float LengthOffset;
+
+	FAedificDirtyRange()
+	{
+		bFullRebuild =	true;
+		StartDistance =	0.f;
+		EndDistance =	MAX_flt;
+		LengthOffset =	0.f;
+	}
+
+	/** If nothing changed since the last build. */
+	bool IsEmpty() const { return !bFullRebuild && StartDistance > EndDistance; }
+};
+
+/** How the spline is split into mesh segments. */
+struct FAedificSegmentation
+{
+	/** If segment boundaries follow the curvature instead of tiling the mesh at its length. */
+	bool bAdaptive;
+
+	/** Maximum distance between the spline and the straight line joining a segment's ends. */
+	float MaxChordDeviation;
+
+	/** Maximum roll of the spline across a segment, in degrees. */
+	float MaxTwistDegrees;
+
+	/** Maximum length of a segment, as a multiple of the mesh length. */
+	float MaxStretch;
+
+	FAedificSegmentation()
+	{
+		bAdaptive =			false;
+		MaxChordDeviation =	0.f;
+		MaxTwistDegrees =	0.f;
+		MaxStretch =		1.f;
+	}
+
+	bool operator==(const FAedificSegmentation& Other) const
+	{
+		return bAdaptive == Other.bAdaptive
+			&& (!bAdaptive || (MaxChordDeviation == Other.MaxChordDeviation && MaxTwistDegrees == Other.MaxTwistDegrees && MaxStretch == Other.MaxStretch));
+	}
+
+	bool operator!=(const FAedificSegmentation& Other) const { return !(*this == Other); }
+};
+
+/** Generator inputs and frames of the last mesh build, used to find out what the next build has to regenerate. */
+struct FAedificMeshBuildState
+{
+	/** Spline points the last build was generated from, in local space. */
+	TArray<FSplinePoint> SplinePoints;
+
+	/** Parallel Transport frame positions of the last build. */
+	TArray<FVector> FramePositions;
+
+	/** Parallel Transport frame tangents of the last build. */
+	FAedificVectorStreams FrameTangents;
+
+	/** Parallel Transport frame normals of the last build. */
+	FAedificVectorStreams FrameNormals;
+
+	/** Length of the mesh used by the last build. */
+	float MeshLength;
+
+	/** Length of the spline at the last build. */
+	float SplineLength;
+
+	/** If the spline was a closed loop at the last build. */
+	bool bClosedLoop;
+
+	/** If the last build used the Parallel Transport generator. */
+	bool bParallelTransport;
+
+	/** Segmentation settings of the last build. */
+	FAedificSegmentation Segmentation;
+
+	/** Hash of every input of the last build, 0 if it must not be reused. */
+	uint64 InputHash;
+
+	FAedificMeshBuildState()
+	{
+		Reset();
+	}
+
+	/** Forgets the last build, forcing the next one to regenerate everything. */
+	void Reset()
+	{
+		SplinePoints.Reset();
+		FramePositions.Reset();
+		FrameTangents.Reset();
+		FrameNormals.Reset();
+		MeshLength =			0.f;
+		SplineLength =			0.f;
+		bClosedLoop =			false;
+		bParallelTransport =	false;
+		Segmentation =			FAedificSegmentation();
+		InputHash =				0;
+	}
 };
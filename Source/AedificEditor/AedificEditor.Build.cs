@@ -24,6 +24,7 @@ public class AedificEditor : ModuleRules
                 "PlacementMode",
                 "Projects",
                 "SlateCore",
+                "UnrealEd",
             }
 		);
     }
@@ -0,0 +1,228 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificRebuildCommandlet.h"
+#include "AedificSplineContinuum.h"
+
+#include <Engine/Engine.h>
+#include <Engine/World.h>
+#include <EngineUtils.h>
+#include <FileHelpers.h>
+#include <Misc/PackageName.h>
+#include <UObject/GarbageCollection.h>
+#include <UObject/Package.h>
+#include <WorldPartition/WorldPartition.h>
+#include <WorldPartition/WorldPartitionHelpers.h>
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AedificRebuildCommandlet)
+
+DEFINE_LOG_CATEGORY_STATIC(LogAedificRebuild, Log, All);
+
+/** Timings and counts of a processed map. */
+struct FAedificMapReport
+{
+	FString MapName;
+	int32 NumContinuums = 0;
+	int32 NumRebuilt = 0;
+	double LoadTime = 0.0;
+	double RebuildTime = 0.0;
+	double SaveTime = 0.0;
+	bool bSucceeded = true;
+};
+
+UAedificRebuildCommandlet::UAedificRebuildCommandlet()
+{
+	// Set default values for UCommandlet interface members.
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+
+	// Set default values for this class members.
+	bForce = false;
+	bNoSave = false;
+}
+
+int32 UAedificRebuildCommandlet::Main(const FString& Params)
+{
+	FString MapsParam;
+	if (!FParse::Value(*Params, TEXT("Maps="), MapsParam, false))
+	{
+		UE_LOG(LogAedificRebuild, Error, TEXT("No map to process. Usage: -run=AedificRebuild -Maps=/Game/Maps/MapA+/Game/Maps/MapB [-Force] [-NoSave]"));
+		return 1;
+	}
+
+	bForce = FParse::Param(*Params, TEXT("Force"));
+	bNoSave = FParse::Param(*Params, TEXT("NoSave"));
+
+	TArray<FString> MapNames;
+	MapsParam.ParseIntoArray(MapNames, TEXT("+"));
+
+	TArray<FAedificMapReport> Reports;
+
+	for (const FString& MapName : MapNames)
+	{
+		FAedificMapReport& Report = Reports.AddDefaulted_GetRef();
+		Report.MapName = MapName;
+
+		const double LoadStart = FPlatformTime::Seconds();
+
+		UPackage* Package = FPackageName::DoesPackageExist(MapName) ? LoadPackage(nullptr, *MapName, LOAD_None) : nullptr;
+		UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+		if (!World)
+		{
+			UE_LOG(LogAedificRebuild, Error, TEXT("Failed to load map %s."), *MapName);
+			Report.bSucceeded = false;
+			continue;
+		}
+
+		// Components are registered, but construction scripts aren't rerun: continuums are only rebuilt below, and only if outdated.
+		World->AddToRoot();
+		World->WorldType = EWorldType::Editor;
+
+		UWorld::InitializationValues InitializationValues;
+		InitializationValues
+			.RequiresHitProxies(false)
+			.ShouldSimulatePhysics(false)
+			.EnableTraceCollision(false)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(true);
+
+		World->InitWorld(InitializationValues);
+		World->UpdateWorldComponents(false, false);
+
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+		WorldContext.SetCurrentWorld(World);
+
+		TGuardValue<UWorld*> WorldGuard(GWorld, World);
+
+		Report.LoadTime = FPlatformTime::Seconds() - LoadStart;
+
+		TArray<AAedificSplineContinuum*> Continuums;
+
+		auto ProcessBatch = [this, &Continuums, &Report]()
+		{
+			if (Continuums.Num() == 0)
+			{
+				return;
+			}
+
+			const double RebuildStart = FPlatformTime::Seconds();
+			Report.NumContinuums += Continuums.Num();
+			Report.NumRebuilt += RebuildContinuums(Continuums);
+			Report.RebuildTime += FPlatformTime::Seconds() - RebuildStart;
+
+			Continuums.Reset();
+
+			if (!bNoSave)
+			{
+				const double SaveStart = FPlatformTime::Seconds();
+				Report.bSucceeded &= SaveDirtyPackages();
+				Report.SaveTime += FPlatformTime::Seconds() - SaveStart;
+			}
+		};
+
+		if (UWorldPartition* WorldPartition = World->GetWorldPartition())
+		{
+			// Actors are loaded in batches, each one is processed and saved before its actors are released.
+			FWorldPartitionHelpers::ForEachActorWithLoading(WorldPartition, AAedificSplineContinuum::StaticClass(),
+				[&Continuums](const FWorldPartitionActorDescInstance* ActorDescInstance)
+				{
+					if (AAedificSplineContinuum* Continuum = Cast<AAedificSplineContinuum>(ActorDescInstance->GetActor()))
+					{
+						Continuums.Add(Continuum);
+					}
+
+					return true;
+				},
+				ProcessBatch);
+		}
+		else
+		{
+			for (TActorIterator<AAedificSplineContinuum> It(World); It; ++It)
+			{
+				Continuums.Add(*It);
+			}
+		}
+
+		ProcessBatch();
+
+		UE_LOG(LogAedificRebuild, Display, TEXT("%s: Rebuilt %d of %d continuums. Load %.2f s, rebuild %.2f s, save %.2f s."),
+			*MapName, Report.NumRebuilt, Report.NumContinuums, Report.LoadTime, Report.RebuildTime, Report.SaveTime);
+
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		World->RemoveFromRoot();
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	// Summary of the whole run.
+	int32 NumFailed = 0;
+	FAedificMapReport Total;
+
+	UE_LOG(LogAedificRebuild, Display, TEXT("Map, Continuums, Rebuilt, Load (s), Rebuild (s), Save (s)"));
+
+	for (const FAedificMapReport& Report : Reports)
+	{
+		UE_LOG(LogAedificRebuild, Display, TEXT("%s, %d, %d, %.2f, %.2f, %.2f%s"), *Report.MapName, Report.NumContinuums, Report.NumRebuilt,
+			Report.LoadTime, Report.RebuildTime, Report.SaveTime, Report.bSucceeded ? TEXT("") : TEXT(", FAILED"));
+
+		Total.NumContinuums += Report.NumContinuums;
+		Total.NumRebuilt += Report.NumRebuilt;
+		Total.LoadTime += Report.LoadTime;
+		Total.RebuildTime += Report.RebuildTime;
+		Total.SaveTime += Report.SaveTime;
+		NumFailed += Report.bSucceeded ? 0 : 1;
+	}
+
+	UE_LOG(LogAedificRebuild, Display, TEXT("Total, %d, %d, %.2f, %.2f, %.2f"), Total.NumContinuums, Total.NumRebuilt, Total.LoadTime, Total.RebuildTime, Total.SaveTime);
+
+	return NumFailed > 0 ? 1 : 0;
+}
+
+int32 UAedificRebuildCommandlet::RebuildContinuums(TConstArrayView<AAedificSplineContinuum*> Continuums) const
+{
+	// Every segment generation is launched before any is waited on, so they run in parallel.
+	TArray<AAedificSplineContinuum*> Rebuilt;
+
+	for (AAedificSplineContinuum* Continuum : Continuums)
+	{
+		if (Continuum->StartBatchRebuild(bForce))
+		{
+			Rebuilt.Add(Continuum);
+		}
+	}
+
+	for (AAedificSplineContinuum* Continuum : Rebuilt)
+	{
+		Continuum->FinishBatchRebuild();
+		Continuum->MarkPackageDirty();
+
+		UE_LOG(LogAedificRebuild, Verbose, TEXT("Rebuilt %s."), *Continuum->GetPathName());
+	}
+
+	return Rebuilt.Num();
+}
+
+bool UAedificRebuildCommandlet::SaveDirtyPackages() const
+{
+	// World packages include the external packages of actors, content packages the baked meshes.
+	TArray<UPackage*> Packages;
+	FEditorFileUtils::GetDirtyWorldPackages(Packages);
+	FEditorFileUtils::GetDirtyContentPackages(Packages);
+
+	if (Packages.Num() == 0)
+	{
+		return true;
+	}
+
+	const bool bSaved = UEditorLoadingAndSavingUtils::SavePackages(Packages, true);
+	if (!bSaved)
+	{
+		UE_LOG(LogAedificRebuild, Error, TEXT("Failed to save some of the %d modified packages."), Packages.Num());
+	}
+
+	return bSaved;
+}
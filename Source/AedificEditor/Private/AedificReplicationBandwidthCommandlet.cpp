@@ -0,0 +1,282 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificReplicationBandwidthCommandlet.h"
+#include "AedificSplineContinuum.h"
+#include "AedificSplineReplication.h"
+
+#include <Components/SplineComponent.h>
+#include <Engine/Engine.h>
+#include <Engine/World.h>
+#include <Math/RandomStream.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <Serialization/BitReader.h>
+#include <Serialization/BitWriter.h>
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AedificReplicationBandwidthCommandlet)
+
+DEFINE_LOG_CATEGORY_STATIC(LogAedificReplicationBandwidth, Log, All);
+
+/** Distances under which a replicated point matches the reference one, quantization included. */
+static constexpr double LocationTolerance = 0.1;
+static constexpr double TangentTolerance = 0.5;
+
+/**
+ * Spawns a continuum along a gently winding line of NumPoints points, Spacing apart. If it doesn't compute its tangents,
+ * every fourth point gets custom tangents.
+ */
+static AAedificSplineContinuum* SpawnContinuum(UWorld* World, const int32 NumPoints, const float Spacing, const bool bComputeTangents)
+{
+	AAedificSplineContinuum* Continuum = World->SpawnActor<AAedificSplineContinuum>();
+	if (!Continuum)
+	{
+		return nullptr;
+	}
+
+	// The setting is protected, the commandlet sets it the way the details panel would.
+	if (FBoolProperty* ComputeTangentsProperty = FindFProperty<FBoolProperty>(AAedificSplineContinuum::StaticClass(), TEXT("bComputeTangents")))
+	{
+		ComputeTangentsProperty->SetPropertyValue_InContainer(Continuum, bComputeTangents);
+	}
+
+	TArray<FVector> Points;
+	Points.SetNumUninitialized(NumPoints);
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		Points[i] = FVector(i * Spacing, FMath::Sin(i * 0.1f) * Spacing, 0.f);
+	}
+
+	USplineComponent* Spline = Continuum->GetSplineComponent();
+	Spline->SetSplinePoints(Points, ESplineCoordinateSpace::Local, false);
+
+	if (!bComputeTangents)
+	{
+		for (int32 i = 0; i < NumPoints; i += 4)
+		{
+			Spline->SetTangentsAtSplinePoint(i, FVector(Spacing, 0.f, 0.f), FVector(Spacing, 0.f, 0.f), ESplineCoordinateSpace::Local, false);
+		}
+	}
+
+	Spline->UpdateSpline();
+
+	Continuum->ComputeSpline();
+	Continuum->RebuildMesh(true);
+
+	return Continuum;
+}
+
+/** Size of a point edit once serialized, in bits. Sends it to Received through the wire format if provided. */
+static int64 SerializeEdit(const FAedificSplinePointEdit& Edit, FAedificSplinePointEdit* Received = nullptr)
+{
+	FAedificSplinePointEdit Sent = Edit;
+	bool bSuccess = true;
+
+	FBitWriter Writer(0, true);
+	Sent.NetSerialize(Writer, nullptr, bSuccess);
+
+	if (Received)
+	{
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		Received->NetSerialize(Reader, nullptr, bSuccess);
+	}
+
+	return Writer.GetNumBits();
+}
+
+/** Checks the points of a replicated spline against the ones of the reference spline, edited directly. Logs the first mismatch. */
+static bool MatchesReference(const USplineComponent* Spline, const USplineComponent* Reference)
+{
+	if (Spline->GetNumberOfSplinePoints() != Reference->GetNumberOfSplinePoints())
+	{
+		UE_LOG(LogAedificReplicationBandwidth, Error, TEXT("%d points instead of %d."), Spline->GetNumberOfSplinePoints(), Reference->GetNumberOfSplinePoints());
+		return false;
+	}
+
+	for (int32 i = 0; i < Reference->GetNumberOfSplinePoints(); ++i)
+	{
+		const bool bTypeMatches = Spline->GetSplinePointType(i) == Reference->GetSplinePointType(i);
+		const bool bLocationMatches = Spline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::Local).Equals(Reference->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::Local), LocationTolerance);
+		const bool bTangentsMatch = Spline->GetArriveTangentAtSplinePoint(i, ESplineCoordinateSpace::Local).Equals(Reference->GetArriveTangentAtSplinePoint(i, ESplineCoordinateSpace::Local), TangentTolerance)
+			&& Spline->GetLeaveTangentAtSplinePoint(i, ESplineCoordinateSpace::Local).Equals(Reference->GetLeaveTangentAtSplinePoint(i, ESplineCoordinateSpace::Local), TangentTolerance);
+
+		if (!bTypeMatches || !bLocationMatches || !bTangentsMatch)
+		{
+			UE_LOG(LogAedificReplicationBandwidth, Error, TEXT("Point %d differs from the reference:%s%s%s"), i,
+				bTypeMatches ? TEXT("") : TEXT(" type"), bLocationMatches ? TEXT("") : TEXT(" location"), bTangentsMatch ? TEXT("") : TEXT(" tangents"));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+UAedificReplicationBandwidthCommandlet::UAedificReplicationBandwidthCommandlet()
+{
+	// Set default values for UCommandlet interface members.
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAedificReplicationBandwidthCommandlet::Main(const FString& Params)
+{
+	FString SizesParam = TEXT("100,10000");
+	FParse::Value(*Params, TEXT("Sizes="), SizesParam);
+
+	int32 NumEdits = 100;
+	FParse::Value(*Params, TEXT("Edits="), NumEdits);
+	NumEdits = FMath::Max(NumEdits, 1);
+
+	float Spacing = 200.f;
+	FParse::Value(*Params, TEXT("Spacing="), Spacing);
+	Spacing = FMath::Max(Spacing, 1.f);
+
+	FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Aedific"), TEXT("ReplicationBandwidth.csv"));
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	TArray<FString> SizeStrings;
+	SizesParam.ParseIntoArray(SizeStrings, TEXT(","));
+
+	// A bare world, the server and client continuums are both spawned in it.
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("AedificReplicationBandwidth"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+	WorldContext.SetCurrentWorld(World);
+
+	FString Csv = TEXT("Points,Tangents,Edits,AvgMoveBytes,AvgAppendBytes,MaxEditBytes,FullArrayQuantizedBytes,FullArrayRawBytes,ClientMatches,ReferenceMatches\n");
+	int32 Result = 0;
+
+	// Every size runs with computed tangents, then with the spline's own, some of them custom, which are replicated.
+	TArray<TPair<int32, bool>> Cases;
+	for (const FString& SizeString : SizeStrings)
+	{
+		const int32 NumPoints = FMath::Max(FCString::Atoi(*SizeString), 2);
+		Cases.Emplace(NumPoints, true);
+		Cases.Emplace(NumPoints, false);
+	}
+
+	for (const TPair<int32, bool>& Case : Cases)
+	{
+		const int32 NumPoints = Case.Key;
+		const bool bComputeTangents = Case.Value;
+		const TCHAR* TangentsName = bComputeTangents ? TEXT("Computed") : TEXT("Spline");
+
+		AAedificSplineContinuum* Server = SpawnContinuum(World, NumPoints, Spacing, bComputeTangents);
+		AAedificSplineContinuum* Client = SpawnContinuum(World, NumPoints, Spacing, bComputeTangents);
+		AAedificSplineContinuum* Reference = SpawnContinuum(World, NumPoints, Spacing, bComputeTangents);
+		if (!Server || !Client || !Reference)
+		{
+			UE_LOG(LogAedificReplicationBandwidth, Error, TEXT("Failed to spawn the continuums."));
+			Result = 1;
+			continue;
+		}
+
+		// What sending every point on each edit would cost instead.
+		int64 FullArrayBits = 0;
+		for (int32 i = 0; i < NumPoints; ++i)
+		{
+			FAedificSplinePointEdit Edit;
+			Edit.Capture(Server->GetSplineComponent(), i, true);
+			FullArrayBits += SerializeEdit(Edit);
+		}
+
+		const int64 FullArrayRawBytes = (int64)NumPoints * sizeof(FSplinePoint);
+
+		// Moves and appends alternate, from the same seed for every size.
+		FRandomStream Random(NumPoints);
+		int64 MoveBits = 0;
+		int64 AppendBits = 0;
+		int64 MaxEditBits = 0;
+		int32 NumMoves = 0;
+		int32 NumAppends = 0;
+
+		for (int32 EditIndex = 0; EditIndex < NumEdits; ++EditIndex)
+		{
+			USplineComponent* ServerSpline = Server->GetSplineComponent();
+			USplineComponent* ReferenceSpline = Reference->GetSplineComponent();
+			const bool bAppend = (EditIndex % 2) == 1;
+
+			// The reference gets the same edits straight on its spline, without any quantization or replication.
+			int32 PointIndex;
+			if (bAppend)
+			{
+				PointIndex = ServerSpline->GetNumberOfSplinePoints();
+				const FVector Last = ServerSpline->GetLocationAtSplinePoint(PointIndex - 1, ESplineCoordinateSpace::Local);
+				const FVector Location = Last + FVector(Spacing, Random.FRandRange(-0.5f, 0.5f) * Spacing, 0.f);
+
+				Server->AddSplinePoint(Location);
+				ReferenceSpline->AddSplinePoint(Location, ESplineCoordinateSpace::Local, false);
+			}
+			else
+			{
+				PointIndex = Random.RandRange(0, ServerSpline->GetNumberOfSplinePoints() - 1);
+				const FVector Location = ServerSpline->GetLocationAtSplinePoint(PointIndex, ESplineCoordinateSpace::Local) + Random.GetUnitVector() * Spacing * 0.25f;
+
+				Server->SetSplinePointLocation(PointIndex, Location);
+				ReferenceSpline->SetLocationAtSplinePoint(PointIndex, Location, ESplineCoordinateSpace::Local, false);
+			}
+
+			Reference->ComputeSpline();
+
+			const FAedificSplinePointEdit* Edit = Server->GetSplineEdits().FindPoint(PointIndex);
+			if (!Edit)
+			{
+				UE_LOG(LogAedificReplicationBandwidth, Error, TEXT("Edit of point %d wasn't recorded."), PointIndex);
+				Result = 1;
+				break;
+			}
+
+			// The client only receives the edited point.
+			FAedificSplinePointEdit Received;
+			const int64 EditBits = SerializeEdit(*Edit, &Received);
+			Client->ApplySplineEdits(MakeArrayView(&Received, 1));
+
+			(bAppend ? AppendBits : MoveBits) += EditBits;
+			(bAppend ? NumAppends : NumMoves) += 1;
+			MaxEditBits = FMath::Max(MaxEditBits, EditBits);
+		}
+
+		// Both sides regenerate from the same quantized points, so their inputs must be identical.
+		const bool bClientMatches = Server->ComputeInputHash() == Client->ComputeInputHash();
+		if (!bClientMatches)
+		{
+			UE_LOG(LogAedificReplicationBandwidth, Error, TEXT("%d points, %s tangents: the client's spline diverged from the server's."), NumPoints, TangentsName);
+			Result = 1;
+		}
+
+		// Both could diverge the same way, they must also match the spline edited without replication.
+		const bool bReferenceMatches = MatchesReference(Server->GetSplineComponent(), Reference->GetSplineComponent()) && MatchesReference(Client->GetSplineComponent(), Reference->GetSplineComponent());
+		if (!bReferenceMatches)
+		{
+			UE_LOG(LogAedificReplicationBandwidth, Error, TEXT("%d points, %s tangents: the replicated spline diverged from the reference one."), NumPoints, TangentsName);
+			Result = 1;
+		}
+
+		const double AvgMoveBytes = NumMoves > 0 ? MoveBits / 8.0 / NumMoves : 0.0;
+		const double AvgAppendBytes = NumAppends > 0 ? AppendBits / 8.0 / NumAppends : 0.0;
+
+		UE_LOG(LogAedificReplicationBandwidth, Display, TEXT("%d points, %s tangents, %d edits: %.1f bytes per move, %.1f per append, %.1f at most, %.1f for the whole array (%lld unquantized), client %s, reference %s."),
+			NumPoints, TangentsName, NumEdits, AvgMoveBytes, AvgAppendBytes, MaxEditBits / 8.0, FullArrayBits / 8.0, FullArrayRawBytes,
+			bClientMatches ? TEXT("matches") : TEXT("diverged"), bReferenceMatches ? TEXT("matches") : TEXT("diverged"));
+
+		Csv += FString::Printf(TEXT("%d,%s,%d,%.2f,%.2f,%.2f,%.1f,%lld,%s,%s\n"),
+			NumPoints, TangentsName, NumEdits, AvgMoveBytes, AvgAppendBytes, MaxEditBits / 8.0, FullArrayBits / 8.0, FullArrayRawBytes,
+			bClientMatches ? TEXT("true") : TEXT("false"), bReferenceMatches ? TEXT("true") : TEXT("false"));
+
+		Server->Destroy();
+		Client->Destroy();
+		Reference->Destroy();
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutputPath))
+	{
+		UE_LOG(LogAedificReplicationBandwidth, Error, TEXT("Failed to write %s."), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogAedificReplicationBandwidth, Display, TEXT("Results written to %s. Sizes are payloads, the fast array adds a few bytes of header per point."), *OutputPath);
+	return Result;
+}
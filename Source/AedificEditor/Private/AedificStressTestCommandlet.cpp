@@ -0,0 +1,198 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificStressTestCommandlet.h"
+#include "AedificSplineContinuum.h"
+
+#include <Components/SplineComponent.h>
+#include <Engine/Engine.h>
+#include <Engine/World.h>
+#include <HAL/PlatformMemory.h>
+#include <Misc/FileHelper.h>
+#include <Misc/Paths.h>
+#include <UObject/GarbageCollection.h>
+#include <UObject/UObjectArray.h>
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AedificStressTestCommandlet)
+
+DEFINE_LOG_CATEGORY_STATIC(LogAedificStressTest, Log, All);
+
+/** Spline shapes the continuums are generated along. */
+enum class EAedificStressShape : uint8
+{
+	Straight,
+	Helix,
+	ClosedLoop,
+	VerticalLoop,
+};
+
+static const TCHAR* GetShapeName(const EAedificStressShape Shape)
+{
+	switch (Shape)
+	{
+	case EAedificStressShape::Straight:		return TEXT("Straight");
+	case EAedificStressShape::Helix:		return TEXT("Helix");
+	case EAedificStressShape::ClosedLoop:	return TEXT("ClosedLoop");
+	case EAedificStressShape::VerticalLoop:	return TEXT("VerticalLoop");
+	default:								return TEXT("Unknown");
+	}
+}
+
+/** Generates the spline points of a shape, about Spacing apart. */
+static void MakeShapePoints(const EAedificStressShape Shape, const int32 NumPoints, const float Spacing, TArray<FVector>& OutPoints, bool& bOutClosedLoop)
+{
+	OutPoints.SetNumUninitialized(NumPoints);
+	bOutClosedLoop = (Shape == EAedificStressShape::ClosedLoop);
+
+	// Circles whose circumference spans all the points.
+	const float Radius = NumPoints * Spacing / UE_TWO_PI;
+
+	for (int32 i = 0; i < NumPoints; ++i)
+	{
+		switch (Shape)
+		{
+		case EAedificStressShape::Straight:
+			OutPoints[i] = FVector(i * Spacing, 0.f, 0.f);
+			break;
+
+		case EAedificStressShape::Helix:
+		{
+			// One turn every 64 points, climbing a fifth of the spacing per point.
+			constexpr int32 PointsPerTurn = 64;
+			const float Angle = UE_TWO_PI * i / PointsPerTurn;
+			const float HelixRadius = Spacing / (2.f * FMath::Sin(UE_PI / PointsPerTurn));
+			OutPoints[i] = FVector(HelixRadius * FMath::Cos(Angle), HelixRadius * FMath::Sin(Angle), i * Spacing * 0.2f);
+			break;
+		}
+
+		case EAedificStressShape::ClosedLoop:
+		{
+			const float Angle = UE_TWO_PI * i / NumPoints;
+			OutPoints[i] = FVector(Radius * FMath::Cos(Angle), Radius * FMath::Sin(Angle), 0.f);
+			break;
+		}
+
+		case EAedificStressShape::VerticalLoop:
+		{
+			// A single loop-the-loop, shifted sideways so its ends don't meet.
+			const float Alpha = (float)i / (float)FMath::Max(NumPoints - 1, 1);
+			const float Angle = UE_TWO_PI * Alpha;
+			OutPoints[i] = FVector(Radius * FMath::Sin(Angle), Radius * 0.25f * Alpha, Radius * (1.f - FMath::Cos(Angle)));
+			break;
+		}
+		}
+	}
+}
+
+UAedificStressTestCommandlet::UAedificStressTestCommandlet()
+{
+	// Set default values for UCommandlet interface members.
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAedificStressTestCommandlet::Main(const FString& Params)
+{
+	FString SizesParam = TEXT("10,100,1000,10000,100000");
+	FParse::Value(*Params, TEXT("Sizes="), SizesParam);
+
+	float Spacing = 200.f;
+	FParse::Value(*Params, TEXT("Spacing="), Spacing);
+	Spacing = FMath::Max(Spacing, 1.f);
+
+	FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Aedific"), TEXT("StressTest.csv"));
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	TArray<FString> SizeStrings;
+	SizesParam.ParseIntoArray(SizeStrings, TEXT(","));
+
+	TArray<int32> Sizes;
+	for (const FString& SizeString : SizeStrings)
+	{
+		Sizes.Add(FMath::Max(FCString::Atoi(*SizeString), 2));
+	}
+
+	// A bare world, enough to register the generated components.
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, TEXT("AedificStressTest"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+	WorldContext.SetCurrentWorld(World);
+
+	FString Csv = TEXT("Shape,Points,Generator,Segments,Components,ComputeSplineMs,RebuildMeshMs,GcMs,UsedMemoryMB,PeakMemoryMB,UObjects\n");
+
+	const EAedificStressShape Shapes[] = { EAedificStressShape::Straight, EAedificStressShape::Helix, EAedificStressShape::ClosedLoop, EAedificStressShape::VerticalLoop };
+
+	for (const EAedificStressShape Shape : Shapes)
+	{
+		for (const int32 NumPoints : Sizes)
+		{
+			for (const bool bParallelTransport : { false, true })
+			{
+				TArray<FVector> Points;
+				bool bClosedLoop = false;
+				MakeShapePoints(Shape, NumPoints, Spacing, Points, bClosedLoop);
+
+				AAedificSplineContinuum* Continuum = World->SpawnActor<AAedificSplineContinuum>();
+				if (!Continuum)
+				{
+					UE_LOG(LogAedificStressTest, Error, TEXT("Failed to spawn a continuum."));
+					continue;
+				}
+
+				USplineComponent* Spline = Continuum->GetSplineComponent();
+				Spline->SetSplinePoints(Points, ESplineCoordinateSpace::Local, false);
+				Spline->SetClosedLoop(bClosedLoop, false);
+				Spline->UpdateSpline();
+
+				Continuum->SetUseParallelTransport(bParallelTransport);
+
+				// Commandlets rebuild synchronously, so both measures cover the whole work.
+				const double ComputeStart = FPlatformTime::Seconds();
+				Continuum->ComputeSpline();
+				const double ComputeTime = FPlatformTime::Seconds() - ComputeStart;
+
+				const double RebuildStart = FPlatformTime::Seconds();
+				Continuum->RebuildMesh(true);
+				const double RebuildTime = FPlatformTime::Seconds() - RebuildStart;
+
+				const int32 NumSegments = Continuum->GetNumSegments();
+				const int32 NumComponents = Continuum->GetNumSplineMeshComponents();
+				const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+				const int32 NumObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+
+				if (NumSegments == 0)
+				{
+					UE_LOG(LogAedificStressTest, Warning, TEXT("%s with %d points generated no segment, is the default mesh missing?"), GetShapeName(Shape), NumPoints);
+				}
+
+				// Collecting the continuum measures how long its components take to clean up.
+				Continuum->Destroy();
+
+				const double GcStart = FPlatformTime::Seconds();
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+				const double GcTime = FPlatformTime::Seconds() - GcStart;
+
+				const TCHAR* GeneratorName = bParallelTransport ? TEXT("ParallelTransport") : TEXT("SplineRotations");
+
+				UE_LOG(LogAedificStressTest, Display, TEXT("%s, %d points, %s: %d segments, compute %.2f ms, rebuild %.2f ms, GC %.2f ms, %d objects."),
+					GetShapeName(Shape), NumPoints, GeneratorName, NumSegments, ComputeTime * 1000.0, RebuildTime * 1000.0, GcTime * 1000.0, NumObjects);
+
+				Csv += FString::Printf(TEXT("%s,%d,%s,%d,%d,%.3f,%.3f,%.3f,%.1f,%.1f,%d\n"),
+					GetShapeName(Shape), NumPoints, GeneratorName, NumSegments, NumComponents, ComputeTime * 1000.0, RebuildTime * 1000.0, GcTime * 1000.0,
+					MemoryStats.UsedPhysical / (1024.0 * 1024.0), MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0), NumObjects);
+			}
+		}
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutputPath))
+	{
+		UE_LOG(LogAedificStressTest, Error, TEXT("Failed to write %s."), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogAedificStressTest, Display, TEXT("Results written to %s."), *OutputPath);
+	return 0;
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include <Commandlets/Commandlet.h>
+
+#include "AedificRebuildCommandlet.generated.h"
+
+class AAedificSplineContinuum;
+
+/**
+ * Regenerates, or bakes, every continuum of a list of maps and saves them, skipping the ones whose inputs didn't change.
+ * Segments of all the loaded continuums are generated in parallel before being applied.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=AedificRebuild -Maps=/Game/Maps/MapA+/Game/Maps/MapB [-Force] [-NoSave]
+ */
+UCLASS()
+class UAedificRebuildCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Sets default values for this commandlet's properties. */
+	UAedificRebuildCommandlet();
+
+	//~ Begin of UCommandlet implementation.
+	virtual int32 Main(const FString& Params) override;
+	//~ End of UCommandlet implementation.
+
+private:
+
+	/** Rebuilds the continuums of a batch, returning the amount actually rebuilt. */
+	int32 RebuildContinuums(TConstArrayView<AAedificSplineContinuum*> Continuums) const;
+
+	/** Saves every dirty map, actor and asset package. Returns false if one failed to save. */
+	bool SaveDirtyPackages() const;
+
+	/** Rebuilds continuums even if their inputs didn't change. */
+	bool bForce;
+
+	/** Leaves the results unsaved, to only measure the rebuild. */
+	bool bNoSave;
+};
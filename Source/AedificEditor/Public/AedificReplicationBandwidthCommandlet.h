@@ -0,0 +1,30 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include <Commandlets/Commandlet.h>
+
+#include "AedificReplicationBandwidthCommandlet.generated.h"
+
+/**
+ * Edits continuums of several sizes as a server would, and records the size of the replicated point deltas of each edit
+ * to a CSV, along with the size of the whole point array. Every delta is sent through the wire format to a second
+ * continuum standing in for a client, which must end up with the same generator inputs. Both must also match a third
+ * continuum getting the same edits straight on its spline. Every size runs with computed tangents, then with the spline's.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=AedificReplicationBandwidth -nullrhi [-Sizes=100,10000] [-Edits=100] [-Spacing=200] [-Output=<File.csv>]
+ */
+UCLASS()
+class UAedificReplicationBandwidthCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Sets default values for this commandlet's properties. */
+	UAedificReplicationBandwidthCommandlet();
+
+	//~ Begin of UCommandlet implementation.
+	virtual int32 Main(const FString& Params) override;
+	//~ End of UCommandlet implementation.
+};
@@ -0,0 +1,27 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include <Commandlets/Commandlet.h>
+
+#include "AedificStressTestCommandlet.generated.h"
+
+/**
+ * Generates continuums of increasing size and shape, and records the cost of computing and rebuilding them to a CSV.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=AedificStressTest -nullrhi [-Sizes=10,100,1000,10000,100000] [-Spacing=200] [-Output=<File.csv>]
+ */
+UCLASS()
+class UAedificStressTestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Sets default values for this commandlet's properties. */
+	UAedificStressTestCommandlet();
+
+	//~ Begin of UCommandlet implementation.
+	virtual int32 Main(const FString& Params) override;
+	//~ End of UCommandlet implementation.
+};
@@ -0,0 +1,26 @@
+// Copyright (c) 2025 Ampere Games.
+
+using UnrealBuildTool;
+
+public class AedificShaders : ModuleRules
+{
+	public AedificShaders(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+		
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+			}
+		);
+			
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Projects",
+				"RenderCore",
+			}
+		);
+    }
+}
@@ -0,0 +1,17 @@
+// Copyright (c) 2025 Ampere Games.
+
+#include "AedificShaders.h"
+
+#include <Interfaces/IPluginManager.h>
+#include <Misc/Paths.h>
+#include <Modules/ModuleManager.h>
+#include <ShaderCore.h>
+
+void FAedificShadersModule::StartupModule()
+{
+	// Expose the plugin's shaders to materials as "/Plugin/Aedific".
+	const FString ShaderDirectory = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("Aedific"))->GetBaseDir(), TEXT("Shaders/Private"));
+	AddShaderSourceDirectoryMapping(TEXT("/Plugin/Aedific"), ShaderDirectory);
+}
+	
+IMPLEMENT_MODULE(FAedificShadersModule, AedificShaders)
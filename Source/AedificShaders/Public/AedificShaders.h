@@ -0,0 +1,13 @@
+// Copyright (c) 2025 Ampere Games.
+
+#pragma once
+
+#include <Modules/ModuleInterface.h>
+
+class FAedificShadersModule : public IModuleInterface
+{
+public:
+	//~ Begin of IModuleInterface implementation.
+	void StartupModule() override;
+	//~ End of IModuleInterface implementation.
+};